@@ -0,0 +1,313 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks of the parameter handler, the controller handler and the communication helpers.
+// Run through colcon test to get the JSON results in the test results directory,
+//  or directly: core_benchmark --benchmark_out=results.json --benchmark_out_format=json
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "lifecycle_msgs/srv/get_state.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "communication_helpers/delta_encoding.hpp"
+#include "communication_helpers/serialization.hpp"
+#include "communication_helpers/service_tools.hpp"
+#include "kroshu_ros2_core/ControllerHandler.hpp"
+#include "kroshu_ros2_core/ParameterHandler.hpp"
+
+using kroshu_ros2_core::ControlMode;
+using kroshu_ros2_core::ControllerType;
+
+namespace
+{
+void initRclcpp()
+{
+  if (!rclcpp::ok()) {
+    rclcpp::init(0, nullptr);
+  }
+}
+
+/**
+ * @brief Node with a parameter handler holding the given number of integer parameters
+ */
+struct ParameterFixture
+{
+  explicit ParameterFixture(std::size_t parameter_count)
+  {
+    static std::atomic<int> node_count {0};
+    initRclcpp();
+    node = std::make_shared<rclcpp::Node>(
+      "parameter_benchmark_" + std::to_string(node_count++));
+    for (std::size_t i = 0; i < parameter_count; ++i) {
+      handler.registerParameter<int>(
+        "param_" + std::to_string(i), 0,
+        [](const int &) {return true;}, node->get_node_parameters_interface());
+      parameters.emplace_back("param_" + std::to_string(i), static_cast<int>(i));
+    }
+  }
+
+  std::shared_ptr<rclcpp::Node> node;
+  kroshu_ros2_core::ParameterHandler handler;
+  std::vector<rclcpp::Parameter> parameters;
+};
+
+void parameterCounts(benchmark::internal::Benchmark * benchmark)
+{
+  for (int count : {10, 100, 1000}) {
+    benchmark->Arg(count);
+  }
+}
+
+// Setting the last registered parameter, the worst case of the lookup
+void BM_OnParamChangeSingle(benchmark::State & state)
+{
+  ParameterFixture fixture(static_cast<std::size_t>(state.range(0)));
+  std::vector<rclcpp::Parameter> last {fixture.parameters.back()};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.handler.onParamChange(last));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OnParamChangeSingle)->Apply(parameterCounts);
+
+// Setting every registered parameter in one request
+void BM_OnParamChangeBatch(benchmark::State & state)
+{
+  ParameterFixture fixture(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.handler.onParamChange(fixture.parameters));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OnParamChangeBatch)->Apply(parameterCounts);
+
+const std::vector<ControlMode> & switchableModes()
+{
+  static const std::vector<ControlMode> modes {
+    ControlMode::JOINT_POSITION_CONTROL, ControlMode::JOINT_IMPEDANCE_CONTROL,
+    ControlMode::JOINT_TORQUE_CONTROL, ControlMode::CARTESIAN_POSITION_CONTROL,
+    ControlMode::CARTESIAN_IMPEDANCE_CONTROL, ControlMode::WRENCH_CONTROL};
+  return modes;
+}
+
+void modePairs(benchmark::internal::Benchmark * benchmark)
+{
+  for (auto from : switchableModes()) {
+    for (auto to : switchableModes()) {
+      benchmark->Args({static_cast<int>(from), static_cast<int>(to)});
+    }
+  }
+}
+
+// Computing the controllers to switch from the first mode to the second one
+void BM_GetControllersForSwitch(benchmark::State & state)
+{
+  kroshu_ros2_core::ControllerHandler handler({"joint_state_broadcaster", "control_mode_handler"});
+  handler.UpdateControllerName(
+    ControllerType::JOINT_POSITION_CONTROLLER_TYPE,
+    "joint_trajectory_controller");
+  handler.UpdateControllerName(
+    ControllerType::CARTESIAN_POSITION_CONTROLLER_TYPE,
+    "cartesian_trajectory_controller");
+  handler.UpdateControllerName(
+    ControllerType::JOINT_IMPEDANCE_CONTROLLER_TYPE,
+    "joint_impedance_controller");
+  handler.UpdateControllerName(
+    ControllerType::CARTESIAN_IMPEDANCE_CONTROLLER_TYPE,
+    "cartesian_impedance_controller");
+  handler.UpdateControllerName(ControllerType::TORQUE_CONTROLLER_TYPE, "effort_controller");
+  handler.UpdateControllerName(ControllerType::WRENCH_CONTROLLER_TYPE, "wrench_controller");
+
+  handler.GetControllersForSwitch(static_cast<ControlMode>(state.range(0)));
+  handler.ApproveControllerActivation();
+  handler.ApproveControllerDeactivation();
+  auto new_mode = static_cast<ControlMode>(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(handler.GetControllersForSwitch(new_mode));
+  }
+}
+BENCHMARK(BM_GetControllersForSwitch)->Apply(modePairs);
+
+// Frame of a 6 axis robot: control mode, cycle counter and status,
+//  then position, velocity and torque of every joint
+constexpr int kFrameIntegers = 3;
+constexpr int kFrameDoubles = 18;
+
+void BM_SerializeFrame(benchmark::State & state)
+{
+  std::vector<std::uint8_t> frame;
+  frame.reserve(kFrameIntegers * sizeof(int) + kFrameDoubles * sizeof(double));
+  int cycle = 0;
+  for (auto _ : state) {
+    frame.clear();
+    kroshu_ros2_core::serializeNext(1, frame);
+    kroshu_ros2_core::serializeNext(cycle++, frame);
+    kroshu_ros2_core::serializeNext(0, frame);
+    for (int i = 0; i < kFrameDoubles; ++i) {
+      kroshu_ros2_core::serializeNext(0.1 * i, frame);
+    }
+    benchmark::DoNotOptimize(frame.data());
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_SerializeFrame);
+
+// Reads the fields from the front of the buffer and erases them, as the receivers do
+void BM_DeserializeFrame(benchmark::State & state)
+{
+  std::vector<std::uint8_t> frame;
+  for (int i = 0; i < kFrameIntegers; ++i) {
+    kroshu_ros2_core::serializeNext(i, frame);
+  }
+  for (int i = 0; i < kFrameDoubles; ++i) {
+    kroshu_ros2_core::serializeNext(0.1 * i, frame);
+  }
+  std::vector<std::uint8_t> buffer;
+  buffer.reserve(frame.size());
+  for (auto _ : state) {
+    buffer.assign(frame.begin(), frame.end());
+    int integer_value;
+    double double_value;
+    for (int i = 0; i < kFrameIntegers; ++i) {
+      auto size = kroshu_ros2_core::deserializeNext(buffer, integer_value);
+      buffer.erase(buffer.begin(), buffer.begin() + size);
+      benchmark::DoNotOptimize(integer_value);
+    }
+    for (int i = 0; i < kFrameDoubles; ++i) {
+      auto size = kroshu_ros2_core::deserializeNext(buffer, double_value);
+      buffer.erase(buffer.begin(), buffer.begin() + size);
+      benchmark::DoNotOptimize(double_value);
+    }
+    // The processed bytes are only valid if the fields consumed the whole frame
+    if (!buffer.empty()) {
+      state.SkipWithError("Deserialization did not consume the whole frame");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_DeserializeFrame);
+
+// Smooth joint positions of a 6 axis robot sampled at 1 kHz
+std::vector<double> jointTrajectory(std::size_t frame_count)
+{
+  std::vector<double> positions(frame_count * 6);
+  for (std::size_t frame = 0; frame < frame_count; ++frame) {
+    for (std::size_t joint = 0; joint < 6; ++joint) {
+      positions[frame * 6 + joint] =
+        (1.0 + 0.3 * joint) * std::sin(0.003 * frame + static_cast<double>(joint));
+    }
+  }
+  return positions;
+}
+
+constexpr std::size_t kTrajectoryFrames = 10000;
+constexpr std::size_t kKeyframeInterval = 1000;
+
+// Encoding the trajectory with the given precision in nanoradians,
+//  the compression ratio is reported against the 8 byte doubles
+void BM_DeltaEncodeTrajectory(benchmark::State & state)
+{
+  auto positions = jointTrajectory(kTrajectoryFrames);
+  std::vector<double> quanta(6, static_cast<double>(state.range(0)) * 1e-9);
+  kroshu_ros2_core::DeltaEncoder encoder(quanta, kKeyframeInterval);
+  std::vector<std::uint8_t> stream;
+  stream.reserve(kTrajectoryFrames * encoder.maxFrameSize());
+  for (auto _ : state) {
+    stream.clear();
+    for (std::size_t frame = 0; frame < kTrajectoryFrames; ++frame) {
+      encoder.encodeNext(positions.data() + frame * 6, stream);
+    }
+    benchmark::DoNotOptimize(stream.data());
+  }
+  state.SetItemsProcessed(state.iterations() * positions.size());
+  state.counters["compression_ratio"] =
+    static_cast<double>(positions.size() * sizeof(double)) / static_cast<double>(stream.size());
+}
+BENCHMARK(BM_DeltaEncodeTrajectory)->Arg(1000)->Arg(10000);
+
+void BM_DeltaDecodeTrajectory(benchmark::State & state)
+{
+  auto positions = jointTrajectory(kTrajectoryFrames);
+  std::vector<double> quanta(6, 1e-6);
+  kroshu_ros2_core::DeltaEncoder encoder(quanta, kKeyframeInterval);
+  std::vector<std::uint8_t> stream;
+  for (std::size_t frame = 0; frame < kTrajectoryFrames; ++frame) {
+    encoder.encodeNext(positions.data() + frame * 6, stream);
+  }
+  std::vector<double> decoded(6);
+  for (auto _ : state) {
+    kroshu_ros2_core::DeltaDecoder decoder(quanta);
+    std::size_t offset = 0;
+    while (offset < stream.size()) {
+      auto size = decoder.decodeNext(
+        stream.data() + offset, stream.size() - offset,
+        decoded.data());
+      if (size == 0) {
+        state.SkipWithError("Decoding failed");
+        break;
+      }
+      offset += static_cast<std::size_t>(size);
+    }
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_DeltaDecodeTrajectory);
+
+// Round trip of a request to a service of the same process, spun on a separate thread
+void BM_SendRequest(benchmark::State & state)
+{
+  using lifecycle_msgs::srv::GetState;
+  initRclcpp();
+  auto server_node = std::make_shared<rclcpp::Node>("send_request_benchmark_server");
+  auto client_node = std::make_shared<rclcpp::Node>("send_request_benchmark_client");
+  auto service = server_node->create_service<GetState>(
+    "benchmark_get_state",
+    [](const GetState::Request::SharedPtr, GetState::Response::SharedPtr response) {
+      response->current_state.id = 3;
+      response->current_state.label = "active";
+    });
+  auto client = client_node->create_client<GetState>("benchmark_get_state");
+
+  rclcpp::executors::MultiThreadedExecutor executor;
+  executor.add_node(server_node);
+  executor.add_node(client_node);
+  std::thread spin_thread([&executor]() {executor.spin();});
+  client->wait_for_service(std::chrono::seconds(5));
+
+  auto request = std::make_shared<GetState::Request>();
+  std::int64_t failures = 0;
+  for (auto _ : state) {
+    auto response = kroshu_ros2_core::sendRequest<GetState::Response>(client, request, 0, 1000);
+    if (!response) {
+      failures++;
+    }
+  }
+  state.counters["failures"] = static_cast<double>(failures);
+
+  executor.cancel();
+  spin_thread.join();
+}
+BENCHMARK(BM_SendRequest)->UseRealTime();
+}  // namespace
@@ -0,0 +1,210 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the default publish path with the intra-process helpers of the base nodes.
+// Usage: intra_process_benchmark [message size in bytes] [number of messages]
+// Publisher and subscription live in the same process and are served by one executor,
+//  so the latency is measured from before publishing until the callback receives the message.
+// A delivery is counted as zero-copy if the subscription receives the buffer that was published.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/u_int8_multi_array.hpp"
+
+#include "kroshu_ros2_core/ROS2BaseNode.hpp"
+
+using std_msgs::msg::UInt8MultiArray;
+
+namespace
+{
+struct Result
+{
+  std::string name;
+  std::size_t received = 0;
+  std::size_t zero_copy = 0;
+  std::vector<double> latencies_us;
+};
+
+class BenchmarkNode : public kroshu_ros2_core::ROS2BaseNode
+{
+public:
+  BenchmarkNode()
+  : kroshu_ros2_core::ROS2BaseNode("intra_process_benchmark")
+  {
+  }
+};
+
+/**
+ * @brief Publishes the given number of messages one by one and waits for each to arrive
+ *
+ * @param publish: Publishes a message with the given size and returns its data pointer
+ */
+template<typename PublishT>
+void measure(
+  rclcpp::Executor & executor, std::size_t message_count, const std::size_t & received_count,
+  const std::uint8_t * const & received_data, PublishT && publish, Result & result)
+{
+  for (std::size_t i = 0; i < message_count && rclcpp::ok(); ++i) {
+    auto expected = received_count + 1;
+    auto start = std::chrono::steady_clock::now();
+    const std::uint8_t * sent_data = publish();
+    auto deadline = start + std::chrono::seconds(1);
+    while (received_count < expected && std::chrono::steady_clock::now() < deadline) {
+      executor.spin_some(std::chrono::milliseconds(1));
+    }
+    if (received_count < expected) {
+      continue;
+    }
+    std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - start;
+    result.latencies_us.push_back(latency.count());
+    result.received++;
+    if (received_data == sent_data) {
+      result.zero_copy++;
+    }
+  }
+}
+
+void printResult(Result & result, std::size_t message_count)
+{
+  auto & latencies = result.latencies_us;
+  std::sort(latencies.begin(), latencies.end());
+  auto quantile = [&latencies](double q) {
+      return latencies.empty() ? 0.0 :
+             latencies[std::min(
+                 latencies.size() - 1,
+                 static_cast<std::size_t>(q * latencies.size()))];
+    };
+  printf(
+    "%-22s %6zu/%-6zu %9zu %10.1f %10.1f %10.1f\n", result.name.c_str(), result.received,
+    message_count, result.zero_copy, quantile(0.5), quantile(0.99),
+    latencies.empty() ? 0.0 : latencies.back());
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  std::size_t message_size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024 * 1024;
+  std::size_t message_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+  auto node = std::make_shared<BenchmarkNode>();
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  auto qos = rclcpp::QoS(rclcpp::KeepLast(10)).reliable();
+
+  std::size_t received_count = 0;
+  const std::uint8_t * received_data = nullptr;
+  std::vector<Result> results;
+
+  {
+    // Default path: the message goes through the middleware and is serialized
+    rclcpp::PublisherOptions publisher_options;
+    publisher_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    rclcpp::SubscriptionOptions subscription_options;
+    subscription_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    auto publisher = node->create_publisher<UInt8MultiArray>(
+      "benchmark/default", qos,
+      publisher_options);
+    auto subscription = node->create_subscription<UInt8MultiArray>(
+      "benchmark/default", qos,
+      [&](UInt8MultiArray::ConstSharedPtr msg) {
+        received_data = msg->data.data();
+        received_count++;
+      }, subscription_options);
+    UInt8MultiArray message;
+    Result result;
+    result.name = "default (const ref)";
+    measure(
+      executor, message_count, received_count, received_data, [&]() {
+        message.data.assign(message_size, 1);
+        publisher->publish(message);
+        return message.data.data();
+      }, result);
+    results.push_back(std::move(result));
+  }
+
+  {
+    // Intra-process path with ownership handed over to the only subscription
+    auto publisher = node->createIntraProcessPublisher<UInt8MultiArray>(
+      "benchmark/intra_process", qos);
+    auto subscription = node->createIntraProcessSubscription<UInt8MultiArray>(
+      "benchmark/intra_process", qos,
+      [&](std::unique_ptr<UInt8MultiArray> msg) {
+        received_data = msg->data.data();
+        received_count++;
+      });
+    Result result;
+    result.name = "intra-process (unique)";
+    measure(
+      executor, message_count, received_count, received_data, [&]() {
+        const std::uint8_t * data = nullptr;
+        kroshu_ros2_core::publishZeroCopy(
+          publisher, [&](UInt8MultiArray & msg) {
+            msg.data.assign(message_size, 1);
+            data = msg.data.data();
+          });
+        return data;
+      }, result);
+    results.push_back(std::move(result));
+  }
+
+  {
+    // Inter-process path of the helper, loans middleware memory if the middleware supports it
+    rclcpp::PublisherOptions publisher_options;
+    publisher_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    rclcpp::SubscriptionOptions subscription_options;
+    subscription_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    auto publisher = node->create_publisher<UInt8MultiArray>(
+      "benchmark/loaned", qos,
+      publisher_options);
+    auto subscription = node->create_subscription<UInt8MultiArray>(
+      "benchmark/loaned", qos,
+      [&](UInt8MultiArray::ConstSharedPtr msg) {
+        received_data = msg->data.data();
+        received_count++;
+      }, subscription_options);
+    Result result;
+    result.name = publisher->can_loan_messages() ? "loaned" : "loaned (not supported)";
+    measure(
+      executor, message_count, received_count, received_data, [&]() {
+        const std::uint8_t * data = nullptr;
+        kroshu_ros2_core::publishZeroCopy(
+          publisher, [&](UInt8MultiArray & msg) {
+            msg.data.assign(message_size, 1);
+            data = msg.data.data();
+          });
+        return data;
+      }, result);
+    results.push_back(std::move(result));
+  }
+
+  printf("Message size: %zu bytes, %zu messages per path\n", message_size, message_count);
+  printf(
+    "%-22s %13s %9s %10s %10s %10s\n", "path", "received", "zero-copy", "p50 [us]",
+    "p99 [us]", "max [us]");
+  for (auto & result : results) {
+    printResult(result, message_count);
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
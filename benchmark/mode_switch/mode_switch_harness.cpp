@@ -0,0 +1,376 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the time from requesting a control mode until the first command cycle in that mode.
+// Started by mode_switch_harness.launch.py next to control_node with mock_components hardware.
+// For every switch the controllers are computed by ControllerHandler and switched through
+//  the controller manager, then a unique command is sent to the controller of the new mode.
+// The cycle is detected when the mock hardware mirrors that command into the joint states.
+// If the command controller of the new mode was already active before the switch, as between
+//  JOINT_POSITION and JOINT_IMPEDANCE, its commands reach the hardware regardless of the switch,
+//  so only the duration of the switch service is reported for these transitions.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "controller_manager_msgs/srv/configure_controller.hpp"
+#include "controller_manager_msgs/srv/load_controller.hpp"
+#include "controller_manager_msgs/srv/switch_controller.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "std_msgs/msg/bool.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
+
+#include "communication_helpers/service_tools.hpp"
+#include "kroshu_ros2_core/ControllerHandler.hpp"
+
+using controller_manager_msgs::srv::ConfigureController;
+using controller_manager_msgs::srv::LoadController;
+using controller_manager_msgs::srv::SwitchController;
+using kroshu_ros2_core::ControlMode;
+using kroshu_ros2_core::ControllerType;
+
+namespace
+{
+/**
+ * @brief Controller commanding a mode and the joint state field mirroring its commands
+ */
+struct ModeSetup
+{
+  std::string name;
+  std::string command_controller;
+  bool mirrored_in_effort;
+};
+
+const std::map<ControlMode, ModeSetup> & modeSetups()
+{
+  static const std::map<ControlMode, ModeSetup> setups {
+    {ControlMode::JOINT_POSITION_CONTROL,
+      {"JOINT_POSITION", "joint_position_controller", false}},
+    {ControlMode::JOINT_IMPEDANCE_CONTROL,
+      {"JOINT_IMPEDANCE", "joint_position_controller", false}},
+    {ControlMode::JOINT_TORQUE_CONTROL,
+      {"JOINT_TORQUE", "joint_effort_controller", true}}};
+  return setups;
+}
+
+struct SwitchSamples
+{
+  std::vector<double> service_ms;
+  std::vector<double> first_command_ms;
+  std::size_t failures = 0;
+  // The switch did not activate the command controller, there is no first command to detect
+  bool service_only = false;
+};
+
+double percentile(std::vector<double> samples, double quantile)
+{
+  if (samples.empty()) {
+    return 0.0;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto index = static_cast<std::size_t>(quantile * (samples.size() - 1) + 0.5);
+  return samples[std::min(index, samples.size() - 1)];
+}
+
+class ModeSwitchHarness : public rclcpp::Node
+{
+public:
+  ModeSwitchHarness()
+  : rclcpp::Node("mode_switch_harness"),
+    controller_handler_({"joint_state_broadcaster"})
+  {
+    repetitions_ = declare_parameter<int>("repetitions", 20);
+    timeout_ = std::chrono::milliseconds(declare_parameter<int>("timeout_ms", 2000));
+    output_file_ = declare_parameter<std::string>("output_file", "");
+    joint_count_ = static_cast<std::size_t>(declare_parameter<int>("joint_count", 6));
+
+    controller_handler_.UpdateControllerName(
+      ControllerType::JOINT_POSITION_CONTROLLER_TYPE,
+      "joint_position_controller");
+    controller_handler_.UpdateControllerName(
+      ControllerType::JOINT_IMPEDANCE_CONTROLLER_TYPE,
+      "joint_impedance_controller");
+    controller_handler_.UpdateControllerName(
+      ControllerType::TORQUE_CONTROLLER_TYPE,
+      "joint_effort_controller");
+
+    auto callback_group = create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+    load_client_ = create_client<LoadController>(
+      "controller_manager/load_controller", rmw_qos_profile_services_default, callback_group);
+    configure_client_ = create_client<ConfigureController>(
+      "controller_manager/configure_controller", rmw_qos_profile_services_default,
+      callback_group);
+    switch_client_ = create_client<SwitchController>(
+      "controller_manager/switch_controller", rmw_qos_profile_services_default, callback_group);
+
+    // The control node reads and writes the hardware only if the robot is configured
+    is_configured_pub_ = create_publisher<std_msgs::msg::Bool>(
+      "robot_manager/is_configured",
+      rclcpp::QoS(rclcpp::KeepLast(1)));
+    is_configured_timer_ = create_wall_timer(
+      std::chrono::milliseconds(100), [this]() {
+        std_msgs::msg::Bool is_configured;
+        is_configured.data = true;
+        is_configured_pub_->publish(is_configured);
+      }, callback_group);
+    for (const auto & controller : {"joint_position_controller", "joint_effort_controller"}) {
+      command_pubs_[controller] = create_publisher<std_msgs::msg::Float64MultiArray>(
+        std::string(controller) + "/commands", rclcpp::SystemDefaultsQoS());
+    }
+    rclcpp::SubscriptionOptions options;
+    options.callback_group = callback_group;
+    joint_state_sub_ = create_subscription<sensor_msgs::msg::JointState>(
+      "joint_states", rclcpp::SensorDataQoS(),
+      [this](sensor_msgs::msg::JointState::SharedPtr msg) {onJointState(*msg);}, options);
+  }
+
+  /**
+   * @brief Runs the scripted switches, the node has to be spun on another thread
+   *
+   * @return False, if the controllers could not be set up
+   */
+  bool run()
+  {
+    for (const auto & controller : {"joint_state_broadcaster", "joint_position_controller",
+        "joint_impedance_controller", "joint_effort_controller"})
+    {
+      if (!loadController(controller)) {
+        RCLCPP_ERROR(get_logger(), "Could not load and configure %s", controller);
+        return false;
+      }
+    }
+
+    std::vector<ControlMode> modes;
+    for (const auto & setup : modeSetups()) {
+      modes.push_back(setup.first);
+    }
+    ControlMode current_mode = ControlMode::UNSPECIFIED_CONTROL_MODE;
+    for (int repetition = 0; repetition < repetitions_ && rclcpp::ok(); ++repetition) {
+      for (auto from : modes) {
+        for (auto to : modes) {
+          if (from == to || !rclcpp::ok()) {
+            continue;
+          }
+          if (current_mode != from) {
+            SwitchSamples unused;
+            switchMode(from, unused);
+          }
+          switchMode(to, samples_[std::make_pair(from, to)]);
+          current_mode = to;
+        }
+      }
+    }
+    report();
+    return true;
+  }
+
+private:
+  bool loadController(const std::string & name)
+  {
+    auto load_request = std::make_shared<LoadController::Request>();
+    load_request->name = name;
+    auto load_response = kroshu_ros2_core::sendRequest<LoadController::Response>(
+      load_client_, load_request, 10000, 2000);
+    if (!load_response || !load_response->ok) {
+      return false;
+    }
+    auto configure_request = std::make_shared<ConfigureController::Request>();
+    configure_request->name = name;
+    auto configure_response = kroshu_ros2_core::sendRequest<ConfigureController::Response>(
+      configure_client_, configure_request, 10000, 2000);
+    return configure_response && configure_response->ok;
+  }
+
+  /**
+   * @brief Switches to the given mode and records the latencies
+   */
+  void switchMode(ControlMode mode, SwitchSamples & samples)
+  {
+    const auto & setup = modeSetups().at(mode);
+    auto start = std::chrono::steady_clock::now();
+    auto controllers = controller_handler_.GetControllersForSwitch(mode);
+    auto request = std::make_shared<SwitchController::Request>();
+    request->activate_controllers = controllers.first;
+    request->deactivate_controllers = controllers.second;
+    request->strictness = SwitchController::Request::STRICT;
+    auto response = kroshu_ros2_core::sendRequest<SwitchController::Response>(
+      switch_client_, request, 0, static_cast<std::uint32_t>(timeout_.count()));
+    auto switched = std::chrono::steady_clock::now();
+    if (!response || !response->ok) {
+      RCLCPP_ERROR(get_logger(), "Switching to %s failed", setup.name.c_str());
+      samples.failures++;
+      return;
+    }
+    controller_handler_.ApproveControllerActivation();
+    controller_handler_.ApproveControllerDeactivation();
+    std::chrono::duration<double, std::milli> service_time = switched - start;
+    if (std::find(
+        controllers.first.begin(), controllers.first.end(),
+        setup.command_controller) == controllers.first.end())
+    {
+      samples.service_only = true;
+      samples.service_ms.push_back(service_time.count());
+      return;
+    }
+
+    // Command a value not seen before until the hardware mirrors it back
+    std_msgs::msg::Float64MultiArray command;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sentinel_ += 0.001;
+      sentinel_in_effort_ = setup.mirrored_in_effort;
+      sentinel_seen_ = false;
+      command.data.assign(joint_count_, sentinel_);
+    }
+    auto & publisher = command_pubs_.at(setup.command_controller);
+    auto deadline = switched + timeout_;
+    while (!sentinel_seen_ && std::chrono::steady_clock::now() < deadline && rclcpp::ok()) {
+      publisher->publish(command);
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    if (!sentinel_seen_) {
+      RCLCPP_ERROR(get_logger(), "No command cycle in %s after the switch", setup.name.c_str());
+      samples.failures++;
+      return;
+    }
+    std::chrono::duration<double, std::milli> first_command_time = sentinel_time_ - start;
+    samples.service_ms.push_back(service_time.count());
+    samples.first_command_ms.push_back(first_command_time.count());
+  }
+
+  void onJointState(const sensor_msgs::msg::JointState & msg)
+  {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto & values = sentinel_in_effort_ ? msg.effort : msg.position;
+    if (!sentinel_seen_ && !values.empty() && values.front() == sentinel_) {
+      sentinel_time_ = now;
+      sentinel_seen_ = true;
+    }
+  }
+
+  void report() const
+  {
+    FILE * output = output_file_.empty() ? nullptr : fopen(output_file_.c_str(), "w");
+    if (output != nullptr) {
+      fprintf(output, "[\n");
+    }
+    printf(
+      "%-34s %5s %5s %10s %10s %10s %10s %12s\n", "transition", "n", "fail", "p50 [ms]",
+      "p90 [ms]", "p99 [ms]", "max [ms]", "service p50");
+    bool first = true;
+    bool service_only_reported = false;
+    for (const auto & entry : samples_) {
+      const auto & samples = entry.second;
+      std::string transition = modeSetups().at(entry.first.first).name + " -> " +
+        modeSetups().at(entry.first.second).name;
+      if (samples.service_only) {
+        service_only_reported = true;
+        printf(
+          "%-34s %5zu %5zu %10s %10s %10s %10s %12.2f\n", transition.c_str(),
+          samples.service_ms.size(), samples.failures, "-", "-", "-", "-",
+          percentile(samples.service_ms, 0.5));
+      } else {
+        printf(
+          "%-34s %5zu %5zu %10.2f %10.2f %10.2f %10.2f %12.2f\n", transition.c_str(),
+          samples.service_ms.size(), samples.failures,
+          percentile(samples.first_command_ms, 0.5), percentile(samples.first_command_ms, 0.9),
+          percentile(samples.first_command_ms, 0.99), percentile(samples.first_command_ms, 1.0),
+          percentile(samples.service_ms, 0.5));
+      }
+      if (output != nullptr) {
+        fprintf(
+          output, "%s  {\"from\": \"%s\", \"to\": \"%s\", \"samples\": %zu, \"failures\": %zu, ",
+          first ? "" : ",\n", modeSetups().at(entry.first.first).name.c_str(),
+          modeSetups().at(entry.first.second).name.c_str(), samples.service_ms.size(),
+          samples.failures);
+        if (samples.service_only) {
+          fprintf(
+            output,
+            "\"service_only\": true, \"p50_ms\": null, \"p90_ms\": null, \"p99_ms\": null, "
+            "\"max_ms\": null, ");
+        } else {
+          fprintf(
+            output,
+            "\"service_only\": false, \"p50_ms\": %.3f, \"p90_ms\": %.3f, \"p99_ms\": %.3f, "
+            "\"max_ms\": %.3f, ", percentile(samples.first_command_ms, 0.5),
+            percentile(samples.first_command_ms, 0.9), percentile(samples.first_command_ms, 0.99),
+            percentile(samples.first_command_ms, 1.0));
+        }
+        fprintf(output, "\"service_p50_ms\": %.3f}", percentile(samples.service_ms, 0.5));
+        first = false;
+      }
+    }
+    if (service_only_reported) {
+      printf(
+        "-: the command controller of the target mode stays active during the switch, "
+        "only the switch service is measured\n");
+    }
+    if (output != nullptr) {
+      fprintf(output, "\n]\n");
+      fclose(output);
+      RCLCPP_INFO(get_logger(), "Results written to %s", output_file_.c_str());
+    }
+  }
+
+  kroshu_ros2_core::ControllerHandler controller_handler_;
+  int repetitions_;
+  std::chrono::milliseconds timeout_;
+  std::string output_file_;
+
+  rclcpp::Client<LoadController>::SharedPtr load_client_;
+  rclcpp::Client<ConfigureController>::SharedPtr configure_client_;
+  rclcpp::Client<SwitchController>::SharedPtr switch_client_;
+  rclcpp::Publisher<std_msgs::msg::Bool>::SharedPtr is_configured_pub_;
+  rclcpp::TimerBase::SharedPtr is_configured_timer_;
+  std::map<std::string, rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr>
+  command_pubs_;
+  rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr joint_state_sub_;
+
+  std::size_t joint_count_;
+  std::mutex mutex_;
+  double sentinel_ = 0.0;
+  bool sentinel_in_effort_ = false;
+  std::atomic_bool sentinel_seen_ {false};
+  std::chrono::steady_clock::time_point sentinel_time_;
+
+  std::map<std::pair<ControlMode, ControlMode>, SwitchSamples> samples_;
+};
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto harness = std::make_shared<ModeSwitchHarness>();
+  rclcpp::executors::MultiThreadedExecutor executor;
+  executor.add_node(harness);
+  std::thread spin_thread([&executor]() {executor.spin();});
+
+  bool success = harness->run();
+
+  executor.cancel();
+  spin_thread.join();
+  rclcpp::shutdown();
+  return success ? 0 : 1;
+}
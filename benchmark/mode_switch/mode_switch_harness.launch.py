@@ -0,0 +1,78 @@
+# Copyright 2026 KUKA Hungaria Kft.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Measure the control mode switch latency with mock hardware.
+
+Starts control_node with the mock_components robot and the dummy controllers of this directory
+and runs mode_switch_harness, the launch shuts down when the harness finishes.
+Switches between JOINT_POSITION and JOINT_IMPEDANCE keep joint_position_controller active,
+so there is no first command cycle to detect: they are reported as switch service only.
+Needs no robot: ros2 launch kroshu_ros2_core mode_switch_harness.launch.py
+"""
+
+import os
+
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, EmitEvent, RegisterEventHandler
+from launch.event_handlers import OnProcessExit
+from launch.events import Shutdown
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+
+def generate_launch_description():
+    share_directory = os.path.join(
+        get_package_share_directory('kroshu_ros2_core'), 'mode_switch'
+    )
+    with open(os.path.join(share_directory, 'mock_robot.urdf'), 'r') as file:
+        robot_description = file.read()
+
+    control_node = Node(
+        package='kroshu_ros2_core',
+        executable='control_node',
+        name='controller_manager',
+        parameters=[
+            {'robot_description': robot_description},
+            os.path.join(share_directory, 'controllers.yaml'),
+        ],
+        output='screen',
+    )
+    harness = Node(
+        package='kroshu_ros2_core',
+        executable='mode_switch_harness',
+        parameters=[
+            {
+                'repetitions': LaunchConfiguration('repetitions'),
+                'output_file': LaunchConfiguration('output_file'),
+            }
+        ],
+        output='screen',
+    )
+    return LaunchDescription(
+        [
+            DeclareLaunchArgument('repetitions', default_value='20'),
+            DeclareLaunchArgument(
+                'output_file',
+                default_value='',
+                description='JSON file for the results, not written if empty',
+            ),
+            control_node,
+            harness,
+            RegisterEventHandler(
+                OnProcessExit(target_action=harness, on_exit=[EmitEvent(event=Shutdown())])
+            ),
+        ]
+    )
@@ -0,0 +1,348 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_HELPERS__DELTA_ENCODING_HPP_
+#define COMMUNICATION_HELPERS__DELTA_ENCODING_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "kroshu_ros2_core/RealTimeSection.hpp"
+
+namespace kroshu_ros2_core
+{
+// Compact stream format for high-rate telemetry, e.g. joint positions of every cycle.
+//
+// Every channel is quantized with its own quantum (the precision of the channel),
+//  the decoded values differ from the encoded ones by at most half of the quantum.
+// A frame is a stream of nibbles padded to whole bytes: the frame type, the frame counter
+//  modulo DELTA_FRAME_COUNTER_MODULO as a varint, then one zig-zag varint of 3 bit groups
+//  per channel:
+//  - keyframe: the quantized values themselves
+//  - delta frame: the difference from the value predicted by the previous two frames
+//    (linear extrapolation), which is a few units for smooth trajectories,
+//    so most values fit in half a byte instead of eight bytes
+// The encoder sends a keyframe every keyframe_interval frames, so a decoder can join
+//  the stream or recover after a lost frame. The decoder detects lost frames by the counter
+//  and rejects delta frames until the next keyframe, instead of decoding them
+//  with a wrong prediction. The prediction uses the quantized values,
+//  so the encoder and the decoder stay in sync without accumulating rounding errors.
+// Quantized values must stay below 2^61 in magnitude, frames with larger or non-finite
+//  values are not encoded.
+
+constexpr std::uint8_t DELTA_FRAME_KEYFRAME = 0;
+constexpr std::uint8_t DELTA_FRAME_DELTA = 1;
+// Fits into two nibbles, losing a multiple of 64 consecutive frames is not detected
+constexpr std::uint64_t DELTA_FRAME_COUNTER_MODULO = 64;
+
+/**
+ * @brief Maps signed integers to unsigned ones so that small magnitudes stay small
+ */
+inline std::uint64_t zigZagEncode(std::int64_t value)
+{
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t zigZagDecode(std::uint64_t value)
+{
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+/**
+ * @brief Appends the value to a nibble stream as a varint of 3 bit groups,
+ *  the top bit of every nibble marks that more groups follow
+ *
+ * Values below 8 take half a byte, which is the typical residual of a smooth trajectory.
+ * Nibbles are written low first, the output must have space for 22 more nibbles.
+ *
+ * @param nibble: Position in nibbles, advanced by the number of nibbles written
+ */
+inline void writeNibbleVarint(std::uint64_t value, std::uint8_t * out, std::size_t & nibble)
+{
+  do {
+    auto group = static_cast<std::uint8_t>(value & 0x7);
+    value >>= 3;
+    if (value != 0) {
+      group |= 0x8;
+    }
+    if (nibble & 1) {
+      out[nibble >> 1] |= static_cast<std::uint8_t>(group << 4);
+    } else {
+      out[nibble >> 1] = group;
+    }
+    nibble++;
+  } while (value != 0);
+}
+
+/**
+ * @brief Reads a varint written by writeNibbleVarint()
+ *
+ * @param nibble_count: Number of nibbles in the input
+ * @return bool: false if the input is truncated or malformed
+ */
+inline bool readNibbleVarint(
+  const std::uint8_t * in, std::size_t nibble_count, std::size_t & nibble,
+  std::uint64_t & value)
+{
+  value = 0;
+  for (unsigned shift = 0; nibble < nibble_count && shift < 64; shift += 3) {
+    auto group = static_cast<std::uint8_t>((in[nibble >> 1] >> ((nibble & 1) * 4)) & 0xF);
+    nibble++;
+    value |= static_cast<std::uint64_t>(group & 0x7) << shift;
+    if ((group & 0x8) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Quantization and prediction state shared by the encoder and the decoder
+ */
+class DeltaCodecState
+{
+public:
+  /**
+   * @param quanta: Precision of each channel, e.g. 1e-6 rad for joint positions
+   */
+  explicit DeltaCodecState(const std::vector<double> & quanta)
+  : quanta_(quanta), inverse_quanta_(quanta.size()), previous_(quanta.size()),
+    before_previous_(quanta.size())
+  {
+    for (std::size_t i = 0; i < quanta_.size(); ++i) {
+      if (!(quanta_[i] > 0.0)) {
+        throw std::invalid_argument("Quanta of the delta encoding must be positive");
+      }
+      inverse_quanta_[i] = 1.0 / quanta_[i];
+    }
+  }
+
+  // 64 bits in 3 bit groups
+  static constexpr std::size_t MAX_VALUE_NIBBLES = 22;
+  // DELTA_FRAME_COUNTER_MODULO - 1 in 3 bit groups
+  static constexpr std::size_t MAX_COUNTER_NIBBLES = 2;
+  // Limit of the quantized values, the residuals of the prediction still fit into 64 bits
+  static constexpr double MAX_QUANTIZED_VALUE = 2305843009213693952.0;  // 2^61
+
+  std::size_t channelCount() const
+  {
+    return quanta_.size();
+  }
+
+  /**
+   * @brief Largest possible size of a frame in bytes
+   */
+  std::size_t maxFrameSize() const
+  {
+    return (1 + MAX_COUNTER_NIBBLES + MAX_VALUE_NIBBLES * quanta_.size() + 1) / 2;
+  }
+
+protected:
+  std::int64_t predict(std::size_t channel) const
+  {
+    switch (history_) {
+      case 0:
+        return 0;
+      case 1:
+        return previous_[channel];
+      default:
+        // Wraps around instead of overflowing on corrupted input of the decoder
+        return static_cast<std::int64_t>(
+          2 * static_cast<std::uint64_t>(previous_[channel]) -
+          static_cast<std::uint64_t>(before_previous_[channel]));
+    }
+  }
+
+  void advance()
+  {
+    std::swap(previous_, before_previous_);
+    if (history_ < 2) {
+      history_++;
+    }
+  }
+
+  std::vector<double> quanta_;
+  std::vector<double> inverse_quanta_;
+  // Written into before_previous_, which becomes previous_ after advance()
+  std::vector<std::int64_t> previous_;
+  std::vector<std::int64_t> before_previous_;
+  int history_ = 0;
+};
+
+class DeltaEncoder : public DeltaCodecState
+{
+public:
+  /**
+   * @param quanta: Precision of each channel
+   * @param keyframe_interval: Number of frames between keyframes, at least 1
+   */
+  DeltaEncoder(const std::vector<double> & quanta, std::size_t keyframe_interval)
+  : DeltaCodecState(quanta), keyframe_interval_(std::max<std::size_t>(keyframe_interval, 1)),
+    frame_(maxFrameSize())
+  {
+  }
+
+  /**
+   * @brief Makes the next frame a keyframe, e.g. when a receiver joins
+   */
+  void requestKeyframe()
+  {
+    frames_since_keyframe_ = keyframe_interval_;
+  }
+
+  /**
+   * @brief Appends the frame of the given values to the output
+   *
+   * Real-time section: reserve maxFrameSize() more bytes in the output in advance.
+   *
+   * @param values: One value for each channel
+   * @return int: Number of bytes appended, 0 if a value is not finite or its quantized value
+   *  is not below 2^61 in magnitude, the frame is skipped then
+   */
+  int encodeNext(const double * values, std::vector<std::uint8_t> & serialized_out)
+  {
+    KROSHU_RT_SECTION();
+    for (std::size_t i = 0; i < quanta_.size(); ++i) {
+      auto scaled = values[i] * inverse_quanta_[i];
+      if (!std::isfinite(scaled) || std::fabs(scaled) >= MAX_QUANTIZED_VALUE) {
+        return 0;
+      }
+    }
+
+    bool keyframe = frames_since_keyframe_ >= keyframe_interval_ || history_ == 0;
+    if (keyframe) {
+      history_ = 0;
+      frames_since_keyframe_ = 0;
+    }
+    frames_since_keyframe_++;
+
+    // Encoded into a scratch buffer, resizing the output would zero-fill the whole frame
+    std::uint8_t * out = frame_.data();
+    out[0] = keyframe ? DELTA_FRAME_KEYFRAME : DELTA_FRAME_DELTA;
+    std::size_t nibble = 1;
+    writeNibbleVarint(frame_counter_, out, nibble);
+    frame_counter_ = (frame_counter_ + 1) % DELTA_FRAME_COUNTER_MODULO;
+    for (std::size_t i = 0; i < quanta_.size(); ++i) {
+      auto scaled = values[i] * inverse_quanta_[i];
+      // Rounding half away from zero without the library call of llround
+      auto quantized = static_cast<std::int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+      writeNibbleVarint(zigZagEncode(quantized - predict(i)), out, nibble);
+      before_previous_[i] = quantized;
+    }
+    advance();
+    auto size = (nibble + 1) / 2;
+    serialized_out.insert(serialized_out.end(), out, out + size);
+    return static_cast<int>(size);
+  }
+
+  int encodeNext(const std::vector<double> & values, std::vector<std::uint8_t> & serialized_out)
+  {
+    if (values.size() != quanta_.size()) {
+      return 0;
+    }
+    return encodeNext(values.data(), serialized_out);
+  }
+
+private:
+  const std::size_t keyframe_interval_;
+  std::size_t frames_since_keyframe_ = 0;
+  std::uint64_t frame_counter_ = 0;
+  std::vector<std::uint8_t> frame_;
+};
+
+class DeltaDecoder : public DeltaCodecState
+{
+public:
+  explicit DeltaDecoder(const std::vector<double> & quanta)
+  : DeltaCodecState(quanta)
+  {
+  }
+
+  /**
+   * @brief Decodes the frame at the start of the input, real-time safe
+   *
+   * Delta frames are rejected until the first keyframe, and after a rejected or lost frame
+   *  until the next keyframe, as the prediction is lost in these cases.
+   * A frame is lost if the counter of a delta frame does not follow the previous one.
+   *
+   * @param values_out: One value for each channel, unchanged if the frame is rejected
+   * @return int: Number of bytes read, 0 if the frame is truncated, malformed or cannot
+   *  be decoded without a keyframe
+   */
+  int decodeNext(const std::uint8_t * serialized_in, std::size_t size, double * values_out)
+  {
+    KROSHU_RT_SECTION();
+    if (size == 0 || (serialized_in[0] & 0xF) > DELTA_FRAME_DELTA) {
+      return reject();
+    }
+    bool keyframe = (serialized_in[0] & 0xF) == DELTA_FRAME_KEYFRAME;
+    if (!keyframe && history_ == 0) {
+      return 0;
+    }
+
+    std::size_t nibble = 1;
+    std::uint64_t frame_counter;
+    if (!readNibbleVarint(serialized_in, 2 * size, nibble, frame_counter) ||
+      frame_counter >= DELTA_FRAME_COUNTER_MODULO)
+    {
+      return reject();
+    }
+    if (keyframe) {
+      history_ = 0;
+    } else if (frame_counter != (frame_counter_ + 1) % DELTA_FRAME_COUNTER_MODULO) {
+      return reject();
+    }
+
+    for (std::size_t i = 0; i < quanta_.size(); ++i) {
+      std::uint64_t encoded;
+      if (!readNibbleVarint(serialized_in, 2 * size, nibble, encoded)) {
+        return reject();
+      }
+      before_previous_[i] = static_cast<std::int64_t>(
+        static_cast<std::uint64_t>(predict(i)) +
+        static_cast<std::uint64_t>(zigZagDecode(encoded)));
+    }
+    frame_counter_ = frame_counter;
+    for (std::size_t i = 0; i < quanta_.size(); ++i) {
+      values_out[i] = static_cast<double>(before_previous_[i]) * quanta_[i];
+    }
+    advance();
+    return static_cast<int>((nibble + 1) / 2);
+  }
+
+  int decodeNext(const std::vector<std::uint8_t> & serialized_in, std::vector<double> & values_out)
+  {
+    if (values_out.size() != quanta_.size()) {
+      return 0;
+    }
+    return decodeNext(serialized_in.data(), serialized_in.size(), values_out.data());
+  }
+
+private:
+  int reject()
+  {
+    history_ = 0;
+    return 0;
+  }
+
+  std::uint64_t frame_counter_ = 0;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // COMMUNICATION_HELPERS__DELTA_ENCODING_HPP_
@@ -17,13 +17,20 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 
+#include "kroshu_ros2_core/RealTimeSection.hpp"
+
 namespace kroshu_ros2_core
 {
 
-int serializeNext(int integer_in, std::vector<std::uint8_t> & serialized_out)
+// These functions are used in real-time loops, so they are marked as real-time sections:
+//  reserve the capacity of the output vectors in advance, growing them is reported
+
+inline int serializeNext(int integer_in, std::vector<std::uint8_t> & serialized_out)
 {
+  KROSHU_RT_SECTION();
   std::uint8_t * bytes = reinterpret_cast<std::uint8_t *>(&integer_in);
   auto it = serialized_out.end();
   serialized_out.insert(it, bytes, bytes + sizeof(int));
@@ -36,37 +43,37 @@ int serializeNext(int integer_in, std::vector<std::uint8_t> & serialized_out)
   return sizeof(int);
 }
 
-int deserializeNext(const std::vector<std::uint8_t> & serialized_in, int & integer_out)
+inline int deserializeNext(const std::vector<std::uint8_t> & serialized_in, int & integer_out)
 {
+  KROSHU_RT_SECTION();
   if (serialized_in.size() < sizeof(int)) {
     // TODO(resizoltan): error
   }
-  std::vector<std::uint8_t> serialized_copy = serialized_in;
-  integer_out = *(reinterpret_cast<int *>(serialized_copy.data()));
+  std::memcpy(&integer_out, serialized_in.data(), sizeof(int));
   return sizeof(int);
 }
 
-int serializeNext(double double_in, std::vector<std::uint8_t> & serialized_out)
+inline int serializeNext(double double_in, std::vector<std::uint8_t> & serialized_out)
 {
+  KROSHU_RT_SECTION();
   std::uint8_t * bytes = reinterpret_cast<std::uint8_t *>(&double_in);
   serialized_out.insert(serialized_out.end(), bytes, bytes + sizeof(double));
 
   // Redefine iterator because of possible invalidation
   auto from_it = std::prev(serialized_out.end(), sizeof(double));
   std::reverse(from_it, serialized_out.end());
-  // TODO(resizoltan): assert that int is 4 bytes long
   // TODO(resizoltan): check endiannes
-  return sizeof(int);
+  return sizeof(double);
 }
 
-int deserializeNext(const std::vector<std::uint8_t> & serialized_in, double & double_out)
+inline int deserializeNext(const std::vector<std::uint8_t> & serialized_in, double & double_out)
 {
+  KROSHU_RT_SECTION();
   if (serialized_in.size() < sizeof(double)) {
     // TODO(resizoltan): error
   }
-  std::vector<std::uint8_t> serialized_copy = serialized_in;
-  double_out = *(reinterpret_cast<int *>(serialized_copy.data()));
-  return sizeof(int);
+  std::memcpy(&double_out, serialized_in.data(), sizeof(double));
+  return sizeof(double);
 }
 
 }  // namespace kroshu_ros2_core
@@ -0,0 +1,155 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__COMPONENTS_HPP_
+#define KROSHU_ROS2_CORE__COMPONENTS_HPP_
+
+#include <string>
+#include <type_traits>
+
+#include "class_loader/class_loader.hpp"
+#include "rclcpp/node_options.hpp"
+#include "rclcpp_components/node_factory.hpp"
+#include "rclcpp_components/node_factory_template.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Makes the options given by a component container available to the base node
+ *  constructed next on the same thread
+ *
+ * Subclasses that do not forward node options to ROS2BaseNode or ROS2BaseLCNode
+ *  still get the remappings, parameters and intra-process setting of the container this way.
+ */
+class ComponentOptionsScope
+{
+public:
+  explicit ComponentOptionsScope(const rclcpp::NodeOptions & options);
+  ~ComponentOptionsScope();
+
+  ComponentOptionsScope(const ComponentOptionsScope &) = delete;
+  ComponentOptionsScope & operator=(const ComponentOptionsScope &) = delete;
+
+  /**
+   * @brief Ends the scope before the destructor, the options are not used afterwards
+   */
+  void release();
+
+  /**
+   * @brief Returns the options of the active scope and ends it,
+   *  or the given options if there is no active scope
+   */
+  static rclcpp::NodeOptions resolve(const rclcpp::NodeOptions & options);
+
+private:
+  const rclcpp::NodeOptions * previous_;
+  bool released_ = false;
+};
+
+/**
+ * @brief Wraps a node class into a component constructible from rclcpp::NodeOptions
+ *
+ * The constructor of the node class is chosen in this order:
+ *  (const rclcpp::NodeOptions &), (const std::string &, const rclcpp::NodeOptions &),
+ *  (), (const std::string &). The string is the default name given by NameT::value(),
+ *  the container overrides it if the component is loaded with a node name.
+ */
+template<typename NodeT, typename NameT>
+class ComponentAdapter : private ComponentOptionsScope, public NodeT
+{
+  struct OptionsConstructor {};
+  struct NameOptionsConstructor {};
+  struct DefaultConstructor {};
+  struct NameConstructor {};
+
+  using Constructor = typename std::conditional<
+    std::is_constructible<NodeT, const rclcpp::NodeOptions &>::value, OptionsConstructor,
+    typename std::conditional<
+      std::is_constructible<NodeT, const std::string &, const rclcpp::NodeOptions &>::value,
+      NameOptionsConstructor,
+      typename std::conditional<
+        std::is_default_constructible<NodeT>::value, DefaultConstructor,
+        NameConstructor>::type>::type>::type;
+
+public:
+  explicit ComponentAdapter(const rclcpp::NodeOptions & options)
+  : ComponentAdapter(options, Constructor())
+  {
+  }
+
+private:
+  ComponentAdapter(const rclcpp::NodeOptions & options, OptionsConstructor)
+  : ComponentOptionsScope(options), NodeT(options)
+  {
+    release();
+  }
+
+  ComponentAdapter(const rclcpp::NodeOptions & options, NameOptionsConstructor)
+  : ComponentOptionsScope(options), NodeT(NameT::value(), options)
+  {
+    release();
+  }
+
+  ComponentAdapter(const rclcpp::NodeOptions & options, DefaultConstructor)
+  : ComponentOptionsScope(options), NodeT()
+  {
+    release();
+  }
+
+  ComponentAdapter(const rclcpp::NodeOptions & options, NameConstructor)
+  : ComponentOptionsScope(options), NodeT(NameT::value())
+  {
+    release();
+  }
+};
+}  // namespace kroshu_ros2_core
+
+#define KROSHU_COMPONENT_CONCAT_IMPL(a, b) a ## b
+#define KROSHU_COMPONENT_CONCAT(a, b) KROSHU_COMPONENT_CONCAT_IMPL(a, b)
+
+#define KROSHU_REGISTER_COMPONENT_IMPL(NodeClass, default_node_name, unique_id) \
+  namespace \
+  { \
+  struct KROSHU_COMPONENT_CONCAT(KroshuComponentName, unique_id) \
+  { \
+    static const char * value() {return default_node_name;} \
+  }; \
+  struct KROSHU_COMPONENT_CONCAT(KroshuComponentProxy, unique_id) \
+  { \
+    KROSHU_COMPONENT_CONCAT(KroshuComponentProxy, unique_id)() \
+    { \
+      class_loader::impl::registerPlugin< \
+        rclcpp_components::NodeFactoryTemplate< \
+          ::kroshu_ros2_core::ComponentAdapter< \
+            NodeClass, KROSHU_COMPONENT_CONCAT(KroshuComponentName, unique_id)>>, \
+        rclcpp_components::NodeFactory>( \
+        "rclcpp_components::NodeFactoryTemplate<" #NodeClass ">", \
+        "rclcpp_components::NodeFactory"); \
+    } \
+  }; \
+  static KROSHU_COMPONENT_CONCAT(KroshuComponentProxy, unique_id) \
+  KROSHU_COMPONENT_CONCAT(kroshu_component_proxy_, unique_id); \
+  }  // namespace
+
+/**
+ * Registers a node class derived from ROS2BaseNode or ROS2BaseLCNode as a component,
+ *  without requiring a constructor that takes only rclcpp::NodeOptions.
+ * Use it in the source file of the node instead of RCLCPP_COMPONENTS_REGISTER_NODE
+ *  and register the plugin in CMake with its fully qualified name as usual:
+ *  rclcpp_components_register_nodes(<library> "<namespace>::<NodeClass>")
+ */
+#define KROSHU_REGISTER_COMPONENT(NodeClass, default_node_name) \
+  KROSHU_REGISTER_COMPONENT_IMPL(NodeClass, default_node_name, __COUNTER__)
+
+#endif  // KROSHU_ROS2_CORE__COMPONENTS_HPP_
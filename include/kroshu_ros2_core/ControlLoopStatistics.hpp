@@ -0,0 +1,189 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__CONTROLLOOPSTATISTICS_HPP_
+#define KROSHU_ROS2_CORE__CONTROLLOOPSTATISTICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Fixed-size log-linear histogram of durations
+ *
+ * The histogram has a single writer (the real-time thread) and any number of readers.
+ * Recording a sample does not allocate, lock or use read-modify-write instructions,
+ * readers get a consistent-enough snapshot of the relaxed atomics.
+ * Every power of two microseconds is split into SUB_BUCKET_COUNT buckets,
+ *  samples above the range of the last bucket are counted in the last bucket.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr std::size_t SUB_BUCKET_COUNT = 4;
+  static constexpr std::size_t BUCKET_COUNT = 64;
+
+  struct Snapshot
+  {
+    std::array<std::uint64_t, BUCKET_COUNT> buckets {};
+    std::uint64_t count = 0;
+    std::int64_t sum_ns = 0;
+    std::int64_t max_ns = 0;
+
+    /**
+     * @brief Average of the recorded samples in nanoseconds, 0 if there are no samples
+     */
+    double mean() const;
+
+    /**
+     * @brief Upper estimate of the given quantile in nanoseconds
+     *
+     * @param quantile: Quantile between 0 and 1
+     * @return std::int64_t: Upper bound of the bucket the quantile falls into,
+     *  limited by the maximum recorded sample, the maximum for the last bucket
+     */
+    std::int64_t quantile(double quantile) const;
+  };
+
+  /**
+   * @brief Records a sample, must be called only from one thread
+   *
+   * @param duration: Duration to record, negative values are recorded as zero
+   */
+  void record(std::chrono::nanoseconds duration);
+
+  /**
+   * @brief Returns a copy of the current state, can be called from any thread
+   */
+  Snapshot snapshot() const;
+
+  /**
+   * @brief Returns the index of the bucket the given number of microseconds belongs to
+   */
+  static std::size_t bucketIndex(std::uint64_t duration_us);
+
+  /**
+   * @brief Returns the exclusive upper bound of a bucket in microseconds
+   */
+  static std::uint64_t bucketUpperBound(std::size_t index);
+
+private:
+  std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_ {};
+  std::atomic<std::uint64_t> count_ {0};
+  std::atomic<std::int64_t> sum_ns_ {0};
+  std::atomic<std::int64_t> max_ns_ {0};
+};
+
+/**
+ * @brief Per-phase timing of the control loop
+ *
+ * Holds one histogram for every phase of the read-update-write cycle,
+ *  the overrun counter and the worst-case values.
+ * The loop is paced by read() blocking until the hardware sends the next state,
+ *  so the read phase includes this wait and the cycle is measured from start to start.
+ * The compute phase is the work done after the state arrived, the margin of the loop.
+ * Written by the real-time thread, read by the thread publishing the statistics.
+ */
+class ControlLoopStatistics
+{
+public:
+  /**
+   * @brief Enum to identify the measured phases of a control cycle
+   */
+  enum class Phase : std::uint8_t
+  {
+    WAKE_UP_JITTER = 0,
+    READ = 1,
+    UPDATE = 2,
+    WRITE = 3,
+    CYCLE = 4,
+    COMPUTE = 5,
+  };
+  static constexpr std::size_t PHASE_COUNT = 6;
+
+  /**
+   * @brief Construct a new control loop statistics object
+   *
+   * @param period: Nominal period of the control loop
+   * @param overrun_tolerance: Cycles longer than the period by more than this
+   *  are counted as overruns
+   */
+  ControlLoopStatistics(
+    std::chrono::nanoseconds period,
+    std::chrono::nanoseconds overrun_tolerance);
+
+  /**
+   * @brief Records the duration of a phase, real-time safe
+   */
+  void recordPhase(Phase phase, std::chrono::nanoseconds duration)
+  {
+    histograms_[static_cast<std::size_t>(phase)].record(duration);
+  }
+
+  /**
+   * @brief Records a whole cycle: the interval since the previous cycle start as the cycle
+   *  and its deviation from the period as jitter, counts an overrun if the interval
+   *  exceeded the period by more than the tolerance, and records the compute phase
+   *
+   * @param cycle_start: Time point at which the cycle started, before reading the hardware
+   * @param compute_start: Time point at which the state was available
+   * @param cycle_end: Time point at which the cycle ended
+   */
+  void recordCycle(
+    std::chrono::steady_clock::time_point cycle_start,
+    std::chrono::steady_clock::time_point compute_start,
+    std::chrono::steady_clock::time_point cycle_end);
+
+  /**
+   * @brief Starts a new chain of cycles, real-time safe
+   *
+   * The next recorded cycle is not compared with the previous one,
+   *  used if the loop was not paced by the hardware in between.
+   */
+  void restartCycles()
+  {
+    first_cycle_ = true;
+  }
+
+  const LatencyHistogram & getHistogram(Phase phase) const
+  {
+    return histograms_[static_cast<std::size_t>(phase)];
+  }
+
+  std::uint64_t getOverrunCount() const
+  {
+    return overruns_.load(std::memory_order_relaxed);
+  }
+
+  std::chrono::nanoseconds getPeriod() const
+  {
+    return period_;
+  }
+
+  static const char * phaseName(Phase phase);
+
+private:
+  const std::chrono::nanoseconds period_;
+  const std::chrono::nanoseconds overrun_tolerance_;
+  std::array<LatencyHistogram, PHASE_COUNT> histograms_;
+  std::atomic<std::uint64_t> overruns_ {0};
+  std::chrono::steady_clock::time_point last_cycle_start_;
+  bool first_cycle_ = true;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__CONTROLLOOPSTATISTICS_HPP_
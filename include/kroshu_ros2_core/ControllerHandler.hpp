@@ -57,13 +57,22 @@ private:
 
   /**
    * @brief These controllers will be activated after they get approved
+   * The controllers are stored sorted by name in a vector, so that calculating a switch
+   *  reuses the storage of the previous one instead of rebuilding a set
    */
-  std::set<std::string> activate_controllers_;
+  std::vector<std::string> activate_controllers_;
 
   /**
    * @brief These controllers will be deactivated after they get approved
+   * The controllers are stored sorted by name in a vector
    */
-  std::set<std::string> deactivate_controllers_;
+  std::vector<std::string> deactivate_controllers_;
+
+  /**
+   * @brief Scratch lists of the switch calculation, pointing to the names of the members above
+   */
+  std::vector<const std::string *> activate_names_;
+  std::vector<const std::string *> deactivate_names_;
 
   /**
    * @brief Look up table for which controllers are needed for each control mode
@@ -106,6 +115,22 @@ public:
   std::pair<std::vector<std::string>, std::vector<std::string>> GetControllersForSwitch(
     ControlMode new_control_mode);
 
+  /**
+   * @brief Calculates the controllers for the control mode change into the given vectors
+   *
+   * The elements of the vectors are assigned in place, so the call does not allocate
+   *  once the vectors and their strings have the capacity of the result, e.g. after a warm-up
+   *  call for the same switch. Used in real-time sections.
+   *
+   * @param new_control_mode: The new control mode
+   * @param activate_controllers_out: The controllers to activate
+   * @param deactivate_controllers_out: The controllers to deactivate
+   * @exception std::out_of_range: new_control_mode attribute is invalid
+   */
+  void GetControllersForSwitch(
+    ControlMode new_control_mode, std::vector<std::string> & activate_controllers_out,
+    std::vector<std::string> & deactivate_controllers_out);
+
   /**
    * @brief Returns all controllers that has active state (used for driver deactivation)
    *
@@ -0,0 +1,188 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__CYCLERECORDER_HPP_
+#define KROSHU_ROS2_CORE__CYCLERECORDER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kroshu_ros2_core
+{
+struct CycleRecorderOptions
+{
+  /**
+   * @brief Directory of the segment files, it must exist
+   */
+  std::string directory = "/tmp";
+
+  /**
+   * @brief Segment files are named <prefix>_<index>.bin
+   */
+  std::string prefix = "cycle_recording";
+
+  /**
+   * @brief Maximum size of the payload of a frame, the frame buffers are reserved with this size
+   */
+  std::size_t max_frame_size = 1024;
+
+  /**
+   * @brief Number of frames the queue between the real-time thread and the writer can hold
+   */
+  std::size_t queue_length = 1024;
+
+  /**
+   * @brief Size of one segment file in bytes
+   */
+  std::size_t segment_size = 64 * 1024 * 1024;
+
+  /**
+   * @brief Number of segment files, the oldest one is overwritten when the last one is full
+   */
+  std::size_t segment_count = 4;
+
+  /**
+   * @brief Period of the writer thread when the queue is empty
+   */
+  std::chrono::milliseconds writer_period {5};
+
+  /**
+   * @brief Sets the segment size so that the segments hold the given history
+   *
+   * @param history: Time span the segments should hold
+   * @param cycle_rate: Number of frames recorded per second
+   */
+  void setHistory(std::chrono::seconds history, double cycle_rate);
+};
+
+/**
+ * @brief Records every control cycle into memory-mapped files for post-mortem analysis
+ *
+ * The real-time thread fills preallocated frame buffers, typically with serializeNext(),
+ *  and hands them over through a wait-free single-producer single-consumer queue.
+ * A background thread copies the frames into preallocated, memory-mapped segment files
+ *  that are written in rotation, so the files always hold the most recent history.
+ * freeze() stops the rotation after the pending frames are written and synced,
+ *  so the history before an error is kept until unfreeze() is called.
+ *
+ * Segment layout: 8 byte magic "KRSHCYC1", 8 byte segment generation, then frames of
+ *  4 byte payload size, 8 byte sequence number, 8 byte time stamp [ns] and the payload,
+ *  all integers in host byte order. A payload size of 0 marks the end of the segment.
+ */
+class CycleRecorder
+{
+public:
+  /**
+   * @brief Creates and maps the segment files and starts the writer thread
+   *
+   * @exception std::runtime_error: the segment files could not be created or mapped
+   */
+  explicit CycleRecorder(const CycleRecorderOptions & options);
+
+  /**
+   * @brief Writes the pending frames and unmaps the segment files
+   */
+  ~CycleRecorder();
+
+  CycleRecorder(const CycleRecorder &) = delete;
+  CycleRecorder & operator=(const CycleRecorder &) = delete;
+
+  /**
+   * @brief Returns an empty frame buffer to fill, real-time safe
+   *
+   * The buffer has max_frame_size capacity reserved, exceeding it allocates.
+   *
+   * @param stamp_ns: Time stamp of the cycle
+   * @return nullptr, if the recorder is frozen or the queue is full,
+   *  in the latter case the frame is counted as dropped
+   */
+  std::vector<std::uint8_t> * beginFrame(std::int64_t stamp_ns);
+
+  /**
+   * @brief Hands the frame returned by the last beginFrame() over to the writer, real-time safe
+   */
+  void commitFrame();
+
+  /**
+   * @brief Keeps the recorded history: no further frames are accepted,
+   *  the writer thread writes the pending frames and syncs the files
+   */
+  void freeze();
+
+  /**
+   * @brief Continues recording after freeze()
+   */
+  void unfreeze();
+
+  bool isFrozen() const
+  {
+    return frozen_.load(std::memory_order_acquire);
+  }
+
+  std::uint64_t getDroppedCount() const
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  std::uint64_t getWrittenCount() const
+  {
+    return written_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Slot
+  {
+    std::int64_t stamp_ns = 0;
+    std::uint64_t sequence = 0;
+    std::vector<std::uint8_t> data;
+  };
+
+  struct Segment
+  {
+    int fd = -1;
+    std::uint8_t * memory = nullptr;
+  };
+
+  void run();
+  std::size_t writePending();
+  void writeFrame(const Slot & slot);
+  void startSegment(std::size_t index);
+  void syncSegments();
+
+  const CycleRecorderOptions options_;
+  std::vector<Slot> slots_;
+  std::atomic<std::size_t> head_ {0};
+  std::atomic<std::size_t> tail_ {0};
+  std::uint64_t next_sequence_ = 0;
+
+  std::vector<Segment> segments_;
+  std::size_t current_segment_ = 0;
+  std::size_t segment_offset_ = 0;
+  std::uint64_t generation_ = 0;
+
+  std::atomic_bool frozen_ {false};
+  std::atomic_bool freeze_requested_ {false};
+  std::atomic_bool stop_ {false};
+  std::atomic<std::uint64_t> dropped_ {0};
+  std::atomic<std::uint64_t> written_ {0};
+  std::thread writer_;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__CYCLERECORDER_HPP_
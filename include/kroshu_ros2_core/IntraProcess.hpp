@@ -0,0 +1,114 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__INTRAPROCESS_HPP_
+#define KROSHU_ROS2_CORE__INTRAPROCESS_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Publisher options with intra-process communication enabled,
+ *  regardless of the intra-process setting of the node
+ */
+inline rclcpp::PublisherOptions intraProcessPublisherOptions()
+{
+  rclcpp::PublisherOptions options;
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  return options;
+}
+
+/**
+ * @brief Subscription options with intra-process communication enabled,
+ *  regardless of the intra-process setting of the node
+ */
+inline rclcpp::SubscriptionOptions intraProcessSubscriptionOptions()
+{
+  rclcpp::SubscriptionOptions options;
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  return options;
+}
+
+/**
+ * @brief Creates a publisher that passes messages to subscriptions of the same process
+ *  without serialization
+ *
+ * Intra-process communication supports only volatile durability, rclcpp throws otherwise.
+ * Publish with publishZeroCopy() or with a std::unique_ptr, publishing a const reference
+ *  copies the message once into the intra-process buffers.
+ *
+ * @param node: rclcpp::Node or rclcpp_lifecycle::LifecycleNode creating the publisher,
+ *  the latter returns a lifecycle publisher that has to be activated
+ */
+template<typename MessageT, typename NodeT>
+auto createIntraProcessPublisher(
+  NodeT & node, const std::string & topic_name, const rclcpp::QoS & qos)
+{
+  return node.template create_publisher<MessageT>(
+    topic_name, qos,
+    intraProcessPublisherOptions());
+}
+
+/**
+ * @brief Creates a subscription that takes ownership of intra-process messages
+ *
+ * If this is the only subscription of an intra-process publisher publishing std::unique_ptr,
+ *  the published message is handed over without any copy. Otherwise rclcpp copies it
+ *  for every additional subscription that takes ownership.
+ */
+template<typename MessageT, typename NodeT>
+auto createIntraProcessSubscription(
+  NodeT & node, const std::string & topic_name, const rclcpp::QoS & qos,
+  std::function<void(std::unique_ptr<MessageT>)> callback,
+  rclcpp::SubscriptionOptions options = intraProcessSubscriptionOptions())
+{
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  return node.template create_subscription<MessageT>(topic_name, qos, callback, options);
+}
+
+/**
+ * @brief Fills and publishes a message with the least copies the publisher supports
+ *
+ * If the publisher has intra-process subscriptions, the message is allocated
+ *  as a std::unique_ptr and moved into the intra-process buffers.
+ * Otherwise, if the middleware supports loaned messages, the message is filled directly
+ *  in middleware memory; if not, it is published as a std::unique_ptr.
+ *
+ * @param publisher: Publisher or lifecycle publisher
+ * @param fill: Called with a reference to the message to fill
+ */
+template<typename PublisherT, typename FillT>
+void publishZeroCopy(PublisherT & publisher, FillT && fill)
+{
+  using MessageT = typename std::decay<decltype(*publisher)>::type::ROSMessageType;
+  if (publisher->get_intra_process_subscription_count() == 0 && publisher->can_loan_messages()) {
+    auto loaned_message = publisher->borrow_loaned_message();
+    fill(loaned_message.get());
+    publisher->publish(std::move(loaned_message));
+    return;
+  }
+  auto message = std::make_unique<MessageT>();
+  fill(*message);
+  publisher->publish(std::move(message));
+}
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__INTRAPROCESS_HPP_
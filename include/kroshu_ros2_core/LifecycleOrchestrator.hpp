@@ -0,0 +1,154 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__LIFECYCLEORCHESTRATOR_HPP_
+#define KROSHU_ROS2_CORE__LIFECYCLEORCHESTRATOR_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "lifecycle_msgs/srv/change_state.hpp"
+#include "lifecycle_msgs/srv/get_state.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Outcome and duration of one lifecycle transition request
+ */
+struct TransitionReport
+{
+  std::string node_name;
+  std::uint8_t transition_id = 0;
+  bool success = false;
+  bool rollback = false;
+  std::chrono::nanoseconds duration {0};
+};
+
+/**
+ * @brief Outcome of a group transition, the reports are in order of completion
+ */
+struct OrchestrationResult
+{
+  bool success = true;
+  bool deadline_exceeded = false;
+  std::vector<TransitionReport> transitions;
+};
+
+/**
+ * @brief Drives a group of lifecycle nodes through their transitions,
+ *  in parallel wherever their dependencies allow
+ *
+ * configure() and activate() start the transition of a node as soon as all of its dependencies
+ *  finished the same transition, deactivate() and cleanup() go in the reverse direction,
+ *  a node starts after every node depending on it finished.
+ * If a transition fails or the deadline is exceeded, no further transitions are started
+ *  and the nodes that completed the transition are rolled back in reverse dependency order,
+ *  the rollback gets the same deadline again.
+ * Requests still pending at the deadline are abandoned, but the nodes may complete them later:
+ *  their state is queried within the first half of the rollback deadline and they are
+ *  rolled back too if they reached the goal state of the transition.
+ * The change_state requests are sent asynchronously through the given node,
+ *  which has to be spun by an executor on another thread, as for sendRequest().
+ */
+class LifecycleOrchestrator
+{
+public:
+  /**
+   * @param node: Node the change_state clients are created with
+   */
+  explicit LifecycleOrchestrator(rclcpp::Node::SharedPtr node);
+
+  /**
+   * @brief Adds a managed node, its dependencies have to be added before,
+   *  so the dependency graph cannot contain cycles
+   *
+   * @param node_name: Name of the lifecycle node, the change_state and get_state services
+   *  are expected at <node_name>/change_state and <node_name>/get_state
+   * @param dependencies: Nodes that have to be configured and activated before this one
+   * @exception std::invalid_argument: the node was already added or a dependency is unknown
+   */
+  void addNode(const std::string & node_name, const std::vector<std::string> & dependencies = {});
+
+  OrchestrationResult configure(std::chrono::milliseconds deadline);
+  OrchestrationResult activate(std::chrono::milliseconds deadline);
+  OrchestrationResult deactivate(std::chrono::milliseconds deadline);
+  OrchestrationResult cleanup(std::chrono::milliseconds deadline);
+
+  /**
+   * @brief Configures and activates every node within the deadline,
+   *  on failure every node is returned to the unconfigured state
+   */
+  OrchestrationResult bringUp(std::chrono::milliseconds deadline);
+
+  /**
+   * @brief Deactivates and cleans up every node within the deadline, no rollback is done
+   */
+  OrchestrationResult bringDown(std::chrono::milliseconds deadline);
+
+  /**
+   * @brief Logs the reports of a result with their durations
+   */
+  void logResult(const OrchestrationResult & result) const;
+
+private:
+  struct ManagedNode
+  {
+    std::string name;
+    std::vector<std::size_t> dependencies;
+    std::vector<std::size_t> dependents;
+    rclcpp::Client<lifecycle_msgs::srv::ChangeState>::SharedPtr client;
+    rclcpp::Client<lifecycle_msgs::srv::GetState>::SharedPtr state_client;
+  };
+
+  /**
+   * @brief Runs a transition on the given nodes and appends the reports to the result
+   *
+   * @param nodes: Indices of the nodes, nodes outside of this set do not block each other
+   * @param reverse: True, if nodes wait for their dependents instead of their dependencies
+   * @param succeeded: Indices of the nodes the transition succeeded on
+   * @param timed_out: Indices of the nodes whose request was abandoned at the deadline
+   * @return True, if the transition succeeded on every node
+   */
+  bool runTransition(
+    const std::vector<std::size_t> & nodes, std::uint8_t transition_id, bool reverse,
+    bool rollback, std::chrono::steady_clock::time_point deadline, OrchestrationResult & result,
+    std::vector<std::size_t> & succeeded, std::vector<std::size_t> & timed_out);
+
+  /**
+   * @brief Queries the state of a node, waiting until it leaves the transition states
+   *
+   * @return The primary state id, PRIMARY_STATE_UNKNOWN if the state could not be queried
+   *  until the deadline
+   */
+  std::uint8_t queryState(std::size_t index, std::chrono::steady_clock::time_point deadline);
+
+  OrchestrationResult runForward(
+    const std::vector<std::uint8_t> & transitions,
+    const std::vector<std::uint8_t> & rollback_transitions, std::chrono::milliseconds deadline);
+
+  OrchestrationResult runReverse(
+    const std::vector<std::uint8_t> & transitions,
+    std::chrono::milliseconds deadline);
+
+  std::vector<std::size_t> allNodes() const;
+
+  rclcpp::Node::SharedPtr node_;
+  std::vector<ManagedNode> nodes_;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__LIFECYCLEORCHESTRATOR_HPP_
@@ -18,12 +18,16 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "rcl_interfaces/msg/parameter_descriptor.hpp"
 #include "rclcpp/node_interfaces/node_parameters_interface.hpp"
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 
+#include "kroshu_ros2_core/RealTimeLogger.hpp"
+
 
 namespace kroshu_ros2_core
 {
@@ -53,6 +57,63 @@ struct ParameterSetAccessRights
   }
 };
 
+/**
+ * @brief Declarative constraints of a parameter
+ *
+ * The constraints are published in the descriptor of the parameter, so clients can query
+ *  them with describe_parameters, and are checked by ParameterHandler for the whole batch
+ *  before any on change callback is called.
+ * Example: ParameterConstraints::integerRange(1, 1000).withDescription("Cycle rate [Hz]")
+ */
+struct ParameterConstraints
+{
+  rcl_interfaces::msg::ParameterDescriptor descriptor;
+
+  /**
+   * @brief Allowed values, any value is allowed if empty
+   */
+  std::vector<rclcpp::ParameterValue> allowed_values;
+
+  /**
+   * @param step: Values must be from + k * step, 0 means no step
+   */
+  static ParameterConstraints integerRange(
+    std::int64_t from, std::int64_t to,
+    std::uint64_t step = 0);
+
+  /**
+   * @param step: Values must be from + k * step, 0 means no step
+   */
+  static ParameterConstraints floatingPointRange(double from, double to, double step = 0.0);
+
+  template<typename T>
+  static ParameterConstraints oneOf(const std::vector<T> & values)
+  {
+    ParameterConstraints constraints;
+    for (const auto & value : values) {
+      constraints.allowed_values.emplace_back(value);
+    }
+    constraints.descriptor.additional_constraints = "One of: " + describeAllowedValues(
+      constraints.allowed_values);
+    return constraints;
+  }
+
+  ParameterConstraints & withDescription(const std::string & description)
+  {
+    descriptor.description = description;
+    return *this;
+  }
+
+  /**
+   * @brief Checks the type independent constraints of the new value
+   *
+   * @param reason: Set to the violated constraint if the value is invalid
+   */
+  bool validate(const rclcpp::Parameter & param, std::string & reason) const;
+
+  static std::string describeAllowedValues(const std::vector<rclcpp::ParameterValue> & values);
+};
+
 class ParameterHandler
 {
   class ParameterBase
@@ -60,8 +121,9 @@ class ParameterHandler
 public:
     ParameterBase(
       const std::string & name, const ParameterSetAccessRights & rights,
-      rclcpp::node_interfaces::NodeParametersInterface::SharedPtr param_IF)
-    : name_(name), rights_(rights), paramIF_(param_IF)
+      rclcpp::node_interfaces::NodeParametersInterface::SharedPtr param_IF,
+      RealTimeLogger & logger)
+    : name_(name), logger_(logger), rights_(rights), paramIF_(param_IF)
     {
     }
 
@@ -82,6 +144,16 @@ public:
       return default_value_;
     }
 
+    const ParameterConstraints & getConstraints() const
+    {
+      return constraints_;
+    }
+
+    void setConstraints(const ParameterConstraints & constraints)
+    {
+      constraints_ = constraints;
+    }
+
     rclcpp::node_interfaces::NodeParametersInterface::SharedPtr getParameterInterface() const
     {
       return paramIF_;
@@ -97,11 +169,13 @@ protected:
       default_value_ = value;
     }
     const std::string name_;
+    RealTimeLogger & logger_;
 
 private:
     const ParameterSetAccessRights rights_;
     rclcpp::node_interfaces::NodeParametersInterface::SharedPtr paramIF_;
     rclcpp::ParameterValue default_value_;
+    ParameterConstraints constraints_;
   };
 
   template<typename T>
@@ -111,8 +185,9 @@ public:
     Parameter(
       const std::string & name, const T & value, const ParameterSetAccessRights & rights,
       std::function<bool(const T &)> on_change_callback,
-      std::shared_ptr<rclcpp::node_interfaces::NodeParametersInterface> paramIF)
-    : ParameterBase(name, rights, paramIF), on_change_callback_(on_change_callback)
+      std::shared_ptr<rclcpp::node_interfaces::NodeParametersInterface> paramIF,
+      RealTimeLogger & logger)
+    : ParameterBase(name, rights, paramIF, logger), on_change_callback_(on_change_callback)
     {
       setDefaultValue(rclcpp::ParameterValue(value));
     }
@@ -124,7 +199,7 @@ public:
       try {
         return on_change_callback_(new_param.get_value<T>());
       } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
-        printf("%s", e.what());
+        KROSHU_RT_LOG_ERROR(logger_, "%s", e.what());
         return false;
       }
     }
@@ -133,7 +208,7 @@ public:
     {
       on_change_callback_ = [this](const T &) -> bool
         {
-          printf("Parameter %s can be set only at startup\n", name_.c_str());
+          KROSHU_RT_LOG_ERROR(logger_, "Parameter %s can be set only at startup", name_);
           return false;
         };
     }
@@ -143,38 +218,83 @@ private:
   };
 
 public:
-  explicit ParameterHandler(rclcpp_lifecycle::LifecycleNode * node = nullptr);
+  explicit ParameterHandler(
+    rclcpp_lifecycle::LifecycleNode * node = nullptr,
+    RealTimeLogger * logger = nullptr);
 
+  /**
+   * @brief Validates the whole batch first: names, access rights, types and constraints,
+   *  the on change callbacks are called only if every parameter is valid
+   *
+   * @return Successful if every callback accepted its value, callbacks that accepted
+   *  their value before a rejecting one are not rolled back
+   */
   rcl_interfaces::msg::SetParametersResult onParamChange(
     const std::vector<rclcpp::Parameter> & parameters) const;
+  /**
+   * @brief Checks the access rights of the parameter in the current state, logs if not allowed
+   */
   bool canSetParameter(const ParameterBase & param) const;
 
+  /**
+   * @brief Checks the access rights of the parameter in the current state without logging
+   *
+   * @param reason: Set to the cause of the rejection
+   */
+  bool canSetParameter(const ParameterBase & param, std::string & reason) const;
+
+  /**
+   * @brief Returns the logger given in the constructor or a shared one if it was not given
+   */
+  RealTimeLogger & getLogger() const;
+
   template<typename T>
   void registerParameter(
     const std::string & name, const T & value, const ParameterSetAccessRights & rights,
     std::function<bool(const T &)> on_change_callback,
-    rclcpp::node_interfaces::NodeParametersInterface::SharedPtr param_IF, bool block = false)
+    rclcpp::node_interfaces::NodeParametersInterface::SharedPtr param_IF, bool block = false,
+    const ParameterConstraints & constraints = ParameterConstraints())
   {
     auto param_shared_ptr = std::make_shared<ParameterHandler::Parameter<T>>(
       name, value, rights,
-      on_change_callback, param_IF);
+      on_change_callback, param_IF, getLogger());
+    param_shared_ptr->setConstraints(constraints);
     registerParameter(param_shared_ptr, block);
   }
   template<typename T>
   void registerParameter(
     const std::string & name, const T & value,
     std::function<bool(const T &)> on_change_callback,
-    rclcpp::node_interfaces::NodeParametersInterface::SharedPtr param_IF, bool block = false)
+    rclcpp::node_interfaces::NodeParametersInterface::SharedPtr param_IF, bool block = false,
+    const ParameterConstraints & constraints = ParameterConstraints())
   {
     auto param_shared_ptr = std::make_shared<ParameterHandler::Parameter<T>>(
       name, value, ParameterSetAccessRights(),
-      on_change_callback, param_IF);
+      on_change_callback, param_IF, getLogger());
+    param_shared_ptr->setConstraints(constraints);
     registerParameter(param_shared_ptr, block);
   }
 
 private:
-  std::vector<std::shared_ptr<ParameterBase>> params_;
+  /**
+   * @brief Checks everything but the callback of one parameter
+   *
+   * @param reason: Set to the cause of the rejection
+   */
+  bool validateParameter(const rclcpp::Parameter & param, std::string & reason) const;
+
+  /**
+   * @brief Returns the descriptor declared with the parameter, the access rights
+   *  are described in the additional constraints for lifecycle nodes
+   */
+  rcl_interfaces::msg::ParameterDescriptor describe(
+    const ParameterBase & param,
+    bool block) const;
+
+  // Looked up by name for every parameter of every set request
+  std::unordered_map<std::string, std::shared_ptr<ParameterBase>> params_;
   rclcpp_lifecycle::LifecycleNode * node_;
+  RealTimeLogger * logger_;
   void registerParameter(std::shared_ptr<ParameterBase> param_shared_ptr, bool block);
 };
 }  // namespace kroshu_ros2_core
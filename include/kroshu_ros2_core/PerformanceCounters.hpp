@@ -0,0 +1,249 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__PERFORMANCECOUNTERS_HPP_
+#define KROSHU_ROS2_CORE__PERFORMANCECOUNTERS_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Lock-free event counter, e.g. for dropped messages or parameter changes
+ *
+ * Counting is a single relaxed atomic add, skipped while the owning
+ *  PerformanceCounters is disabled.
+ */
+class PerformanceCounter
+{
+public:
+  explicit PerformanceCounter(std::shared_ptr<const std::atomic_bool> enabled)
+  : enabled_(enabled)
+  {
+  }
+
+  void increment(std::uint64_t count = 1)
+  {
+    if (enabled_->load(std::memory_order_relaxed)) {
+      value_.fetch_add(count, std::memory_order_relaxed);
+    }
+  }
+
+  std::uint64_t value() const
+  {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<const std::atomic_bool> enabled_;
+  std::atomic<std::uint64_t> value_ {0};
+};
+
+/**
+ * @brief Lock-free duration statistics, e.g. for callback execution times or queue delays
+ *
+ * Can be recorded from any number of threads. While the owning PerformanceCounters
+ *  is disabled, the scopes do not even read the clock.
+ */
+class PerformanceTimer
+{
+public:
+  /**
+   * @brief Records the time between its construction and destruction
+   */
+  class Scope
+  {
+public:
+    explicit Scope(PerformanceTimer & timer)
+    : timer_(timer.isEnabled() ? &timer : nullptr)
+    {
+      if (timer_ != nullptr) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~Scope()
+    {
+      if (timer_ != nullptr) {
+        timer_->record(std::chrono::steady_clock::now() - start_);
+      }
+    }
+
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+private:
+    PerformanceTimer * timer_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  explicit PerformanceTimer(std::shared_ptr<const std::atomic_bool> enabled)
+  : enabled_(enabled)
+  {
+  }
+
+  bool isEnabled() const
+  {
+    return enabled_->load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Records a measured duration, e.g. the age of a message at the start of its callback
+   */
+  void record(std::chrono::nanoseconds duration)
+  {
+    if (!isEnabled()) {
+      return;
+    }
+    auto duration_ns = std::max<std::int64_t>(duration.count(), 0);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+    auto max_ns = max_ns_.load(std::memory_order_relaxed);
+    while (duration_ns > max_ns &&
+      !max_ns_.compare_exchange_weak(max_ns, duration_ns, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  std::uint64_t count() const
+  {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  std::int64_t sumNanoseconds() const
+  {
+    return sum_ns_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the longest duration since the previous call and restarts the maximum
+   */
+  std::int64_t takeMaxNanoseconds()
+  {
+    return max_ns_.exchange(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<const std::atomic_bool> enabled_;
+  std::atomic<std::uint64_t> count_ {0};
+  std::atomic<std::int64_t> sum_ns_ {0};
+  std::atomic<std::int64_t> max_ns_ {0};
+};
+
+/**
+ * @brief Named counters and timers of a node
+ *
+ * Registration locks and allocates, so it belongs to the configuration of the node,
+ *  counting and timing through the returned objects are lock-free.
+ * Everything is disabled by default, disabled counters cost one relaxed load.
+ */
+class PerformanceCounters
+{
+public:
+  /**
+   * @brief Returns the counter with the given name, created at the first call
+   */
+  std::shared_ptr<PerformanceCounter> addCounter(const std::string & name);
+
+  /**
+   * @brief Returns the timer with the given name, created at the first call
+   */
+  std::shared_ptr<PerformanceTimer> addTimer(const std::string & name);
+
+  void setEnabled(bool enabled);
+
+  bool isEnabled() const
+  {
+    return enabled_->load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Aggregates the values since the previous report into a diagnostic status
+   *  named <node_name>: performance
+   *
+   * Counters are reported with their total and rate, timers with their count,
+   *  rate, mean and maximum since the previous report.
+   */
+  diagnostic_msgs::msg::DiagnosticStatus report(const std::string & node_name);
+
+private:
+  struct CounterEntry
+  {
+    std::shared_ptr<PerformanceCounter> counter;
+    std::uint64_t reported_value = 0;
+  };
+
+  struct TimerEntry
+  {
+    std::shared_ptr<PerformanceTimer> timer;
+    std::uint64_t reported_count = 0;
+    std::int64_t reported_sum_ns = 0;
+  };
+
+  void restartReport();
+
+  std::shared_ptr<std::atomic_bool> enabled_ {std::make_shared<std::atomic_bool>(false)};
+  std::mutex mutex_;
+  std::map<std::string, CounterEntry> counters_;
+  std::map<std::string, TimerEntry> timers_;
+  std::chrono::steady_clock::time_point last_report_;
+};
+
+/**
+ * @brief Publishes the report of a PerformanceCounters on /diagnostics periodically
+ *
+ * The publisher and the timer are created at the first enabling, so a node
+ *  that never enables its counters does not pay for them.
+ */
+class PerformanceReporter
+{
+public:
+  PerformanceReporter(
+    PerformanceCounters & counters,
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base,
+    rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr node_topics,
+    rclcpp::node_interfaces::NodeTimersInterface::SharedPtr node_timers,
+    rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock);
+
+  /**
+   * @brief Sets the publishing period and enables the counters, 0 disables both
+   *
+   * @return false if the period is negative
+   */
+  bool setPeriod(std::int64_t period_ms);
+
+private:
+  void publish();
+
+  PerformanceCounters & counters_;
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_;
+  rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr node_topics_;
+  rclcpp::node_interfaces::NodeTimersInterface::SharedPtr node_timers_;
+  rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr publisher_;
+  rclcpp::TimerBase::SharedPtr timer_;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__PERFORMANCECOUNTERS_HPP_
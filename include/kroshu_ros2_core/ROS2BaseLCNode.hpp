@@ -19,11 +19,20 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <functional>
 
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
 
+#include "kroshu_ros2_core/CycleRecorder.hpp"
+#include "kroshu_ros2_core/IntraProcess.hpp"
 #include "kroshu_ros2_core/ParameterHandler.hpp"
+#include "kroshu_ros2_core/PerformanceCounters.hpp"
+#include "kroshu_ros2_core/RealTimeLogger.hpp"
+#include "kroshu_ros2_core/RealTimePublisher.hpp"
+#include "kroshu_ros2_core/TransitionMetrics.hpp"
 
 namespace kroshu_ros2_core
 {
@@ -34,6 +43,12 @@ public:
     const std::string & node_name,
     const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
 
+  /**
+   * @brief Constructor for components, the node is named "base_lifecycle_node"
+   *  unless the container remaps the node name
+   */
+  explicit ROS2BaseLCNode(const rclcpp::NodeOptions & options);
+
   rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
   on_configure(const rclcpp_lifecycle::State &) override;
 
@@ -71,8 +86,107 @@ public:
       name, value, rights,
       on_change_callback, this->get_node_parameters_interface(), true);
   }
+
+  /**
+   * @brief Registers a parameter with declarative constraints, invalid values are rejected
+   *  before the callback is called and clients can query the constraints
+   */
+  template<typename T>
+  void registerParameter(
+    const std::string & name, const T & value, const ParameterSetAccessRights & rights,
+    const ParameterConstraints & constraints, std::function<bool(const T &)> on_change_callback)
+  {
+    param_handler_.registerParameter<T>(
+      name, value, rights,
+      on_change_callback, this->get_node_parameters_interface(), false, constraints);
+  }
+
+  template<typename T>
+  void registerStaticParameter(
+    const std::string & name, const T & value, const ParameterSetAccessRights & rights,
+    const ParameterConstraints & constraints, std::function<bool(const T &)> on_change_callback)
+  {
+    param_handler_.registerParameter<T>(
+      name, value, rights,
+      on_change_callback, this->get_node_parameters_interface(), true, constraints);
+  }
   const ParameterHandler & getParameterHandler() const;
 
+  /**
+   * @brief Logger that can be used from real-time threads with the KROSHU_RT_LOG_* macros,
+   *  records are forwarded to the logger of the node
+   */
+  RealTimeLogger & getRealTimeLogger();
+
+  /**
+   * @brief Counters and timers of the node, published on /diagnostics
+   *  every performance_counters_period_ms milliseconds, disabled if the period is 0 (default)
+   *
+   * Register the counters while configuring the node, e.g. dropped messages with
+   *  addCounter("dropped_messages") or callback times with addTimer("joint_state_callback")
+   *  and a PerformanceTimer::Scope in the callback.
+   * The parameter changes and the duration of the parameter callback are counted by default.
+   */
+  PerformanceCounters & getPerformanceCounters();
+
+  /**
+   * @brief Creates a publisher with intra-process communication enabled,
+   *  publish with publishZeroCopy() to avoid copying the messages
+   */
+  template<typename MessageT>
+  auto createIntraProcessPublisher(const std::string & topic_name, const rclcpp::QoS & qos)
+  {
+    return kroshu_ros2_core::createIntraProcessPublisher<MessageT>(*this, topic_name, qos);
+  }
+
+  /**
+   * @brief Creates a subscription that takes ownership of intra-process messages
+   */
+  template<typename MessageT>
+  auto createIntraProcessSubscription(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    std::function<void(std::unique_ptr<MessageT>)> callback)
+  {
+    return kroshu_ros2_core::createIntraProcessSubscription<MessageT>(
+      *this, topic_name, qos,
+      callback);
+  }
+
+  /**
+   * @brief Creates a publisher for real-time threads, it accepts messages
+   *  only while the node is active
+   *
+   * @param prototype: Initial content of the message slot, with the arrays already resized
+   */
+  template<typename MessageT>
+  std::shared_ptr<RealTimePublisher<MessageT>> createRealTimePublisher(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    const MessageT & prototype = MessageT())
+  {
+    // A plain publisher, the activation is handled by the real-time publisher
+    auto publisher = std::make_shared<RealTimePublisher<MessageT>>(
+      rclcpp::create_publisher<MessageT>(this->get_node_topics_interface(), topic_name, qos),
+      prototype);
+    if (get_current_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE) {
+      publisher->activate();
+    }
+    std::lock_guard<std::mutex> lock(rt_publishers_mutex_);
+    rt_publishers_.push_back(publisher);
+    return publisher;
+  }
+
+  /**
+   * @brief Registers a recorder that is frozen when the node enters the ErrorProcessing state,
+   *  so that the history before the error is kept even if on_error() is overridden
+   */
+  void registerCycleRecorder(std::shared_ptr<CycleRecorder> recorder);
+
+  /**
+   * @brief Returns the metrics of the last run of each lifecycle transition,
+   *  the same metrics are published on ~/transition_metrics with transient local durability
+   */
+  std::map<std::string, TransitionMetrics> getTransitionMetrics() const;
+
 protected:
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr ParamCallback() const;
   static const rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn SUCCESS =
@@ -83,8 +197,26 @@ protected:
     rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::FAILURE;
 
 private:
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn measureTransition(
+    const std::string & transition,
+    const std::function<rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn()>
+    & callback);
+
+  void setRealTimePublishersActive(bool active);
+
+  RealTimeLogger rt_logger_;
   ParameterHandler param_handler_;
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr param_callback_;
+  PerformanceCounters performance_counters_;
+  std::shared_ptr<PerformanceCounter> parameter_changes_;
+  std::shared_ptr<PerformanceTimer> parameter_callback_timer_;
+  std::unique_ptr<PerformanceReporter> performance_reporter_;
+  std::vector<std::shared_ptr<CycleRecorder>> cycle_recorders_;
+  mutable std::mutex transition_metrics_mutex_;
+  std::map<std::string, TransitionMetrics> transition_metrics_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr transition_metrics_pub_;
+  std::mutex rt_publishers_mutex_;
+  std::vector<std::weak_ptr<RealTimePublisherBase>> rt_publishers_;
 };
 
 }  // namespace kroshu_ros2_core
@@ -24,7 +24,10 @@
 #include "rclcpp/node.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 
+#include "kroshu_ros2_core/IntraProcess.hpp"
 #include "kroshu_ros2_core/ParameterHandler.hpp"
+#include "kroshu_ros2_core/PerformanceCounters.hpp"
+#include "kroshu_ros2_core/RealTimeLogger.hpp"
 
 namespace kroshu_ros2_core
 {
@@ -35,7 +38,54 @@ public:
     const std::string & node_name,
     const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
 
+  /**
+   * @brief Constructor for components, the node is named "base_node"
+   *  unless the container remaps the node name
+   */
+  explicit ROS2BaseNode(const rclcpp::NodeOptions & options);
+
   const ParameterHandler & getParameterHandler() const;
+
+  /**
+   * @brief Logger that can be used from real-time threads with the KROSHU_RT_LOG_* macros,
+   *  records are forwarded to the logger of the node
+   */
+  RealTimeLogger & getRealTimeLogger();
+
+  /**
+   * @brief Counters and timers of the node, published on /diagnostics
+   *  every performance_counters_period_ms milliseconds, disabled if the period is 0 (default)
+   *
+   * Register the counters while configuring the node, e.g. dropped messages with
+   *  addCounter("dropped_messages") or callback times with addTimer("joint_state_callback")
+   *  and a PerformanceTimer::Scope in the callback.
+   * The parameter changes and the duration of the parameter callback are counted by default.
+   */
+  PerformanceCounters & getPerformanceCounters();
+
+  /**
+   * @brief Creates a publisher with intra-process communication enabled,
+   *  publish with publishZeroCopy() to avoid copying the messages
+   */
+  template<typename MessageT>
+  auto createIntraProcessPublisher(const std::string & topic_name, const rclcpp::QoS & qos)
+  {
+    return kroshu_ros2_core::createIntraProcessPublisher<MessageT>(*this, topic_name, qos);
+  }
+
+  /**
+   * @brief Creates a subscription that takes ownership of intra-process messages
+   */
+  template<typename MessageT>
+  auto createIntraProcessSubscription(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    std::function<void(std::unique_ptr<MessageT>)> callback)
+  {
+    return kroshu_ros2_core::createIntraProcessSubscription<MessageT>(
+      *this, topic_name, qos,
+      callback);
+  }
+
   template<typename T>
   void registerParameter(
     const std::string & name, const T & value,
@@ -56,12 +106,41 @@ public:
       on_change_callback, this->get_node_parameters_interface(), true);
   }
 
+  /**
+   * @brief Registers a parameter with declarative constraints, invalid values are rejected
+   *  before the callback is called and clients can query the constraints
+   */
+  template<typename T>
+  void registerParameter(
+    const std::string & name, const T & value, const ParameterConstraints & constraints,
+    std::function<bool(const T &)> on_change_callback)
+  {
+    param_handler_.registerParameter<T>(
+      name, value,
+      on_change_callback, this->get_node_parameters_interface(), false, constraints);
+  }
+
+  template<typename T>
+  void registerStaticParameter(
+    const std::string & name, const T & value, const ParameterConstraints & constraints,
+    std::function<bool(const T &)> on_change_callback)
+  {
+    param_handler_.registerParameter<T>(
+      name, value,
+      on_change_callback, this->get_node_parameters_interface(), true, constraints);
+  }
+
 protected:
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr ParamCallback() const;
 
 private:
+  RealTimeLogger rt_logger_;
   ParameterHandler param_handler_;
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr param_callback_;
+  PerformanceCounters performance_counters_;
+  std::shared_ptr<PerformanceCounter> parameter_changes_;
+  std::shared_ptr<PerformanceTimer> parameter_callback_timer_;
+  std::unique_ptr<PerformanceReporter> performance_reporter_;
 };
 }  // namespace kroshu_ros2_core
 
@@ -0,0 +1,293 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__REALTIMELOGGER_HPP_
+#define KROSHU_ROS2_CORE__REALTIMELOGGER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "rclcpp/logger.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Enum to identify the severity of a real-time log record
+ */
+enum class LogSeverity : std::uint8_t
+{
+  DEBUG = 0,
+  INFO = 1,
+  WARN = 2,
+  ERROR = 3,
+  FATAL = 4,
+};
+
+/**
+ * @brief State of one logging call site, used for rate limiting
+ *
+ * Has a constexpr constructor, so function-local static instances are constant-initialized
+ *  and the first log call does not take the static initialization guard.
+ */
+struct LogCallSite
+{
+  constexpr LogCallSite(LogSeverity severity, std::int64_t min_interval_ns)
+  : severity(severity), min_interval_ns(min_interval_ns)
+  {
+  }
+
+  const LogSeverity severity;
+  const std::int64_t min_interval_ns;
+  std::atomic<std::int64_t> last_log_ns {std::numeric_limits<std::int64_t>::min()};
+  std::atomic<std::uint64_t> suppressed {0};
+};
+
+/**
+ * @brief Argument of a log record, strings are copied into the record
+ */
+struct LogArgument
+{
+  enum class Type : std::uint8_t
+  {
+    SIGNED,
+    UNSIGNED,
+    FLOATING,
+    STRING,
+    POINTER,
+  };
+
+  Type type;
+  union {
+    std::int64_t signed_value;
+    std::uint64_t unsigned_value;
+    double floating_value;
+    std::size_t string_offset;
+    const void * pointer_value;
+  };
+};
+
+/**
+ * @brief Fixed-size log record: format string literal and copies of the arguments
+ */
+struct LogRecord
+{
+  static constexpr std::size_t MAX_ARGUMENTS = 8;
+  static constexpr std::size_t STRING_CAPACITY = 128;
+
+  const char * format = nullptr;
+  LogSeverity severity = LogSeverity::INFO;
+  std::uint64_t suppressed = 0;
+  std::size_t argument_count = 0;
+  LogArgument arguments[MAX_ARGUMENTS];
+  std::size_t string_length = 0;
+  char strings[STRING_CAPACITY];
+};
+
+/**
+ * @brief Logger that can be used from real-time threads
+ *
+ * log() copies the format string literal and the arguments into a fixed-size record
+ *  and pushes it into a preallocated lock-free queue, it does not format, allocate or lock.
+ * A background thread shared by all instances drains the queues, formats the records
+ *  and forwards them to rclcpp logging under the name given in the constructor.
+ * If the queue is full, the record is dropped and counted.
+ * Use the KROSHU_RT_LOG_* macros, they provide a rate-limited call site for every call.
+ */
+class RealTimeLogger
+{
+public:
+  /**
+   * @brief Construct a new real-time logger and register it for draining
+   *
+   * @param logger_name: Name of the rclcpp logger the records are forwarded to
+   * @param capacity: Number of records the queue can hold, rounded up to a power of two
+   */
+  explicit RealTimeLogger(const std::string & logger_name, std::size_t capacity = 256);
+
+  /**
+   * @brief Unregister the logger and forward the records still in the queue
+   */
+  ~RealTimeLogger();
+
+  RealTimeLogger(const RealTimeLogger &) = delete;
+  RealTimeLogger & operator=(const RealTimeLogger &) = delete;
+
+  /**
+   * @brief Queues a record, real-time safe
+   *
+   * @param site: Call site of the log, records are dropped if it logged within its interval
+   * @param format: printf-style format string literal, must outlive the logger
+   * @param args: Integral, floating point, string or pointer arguments, at most MAX_ARGUMENTS
+   */
+  template<typename ... Args>
+  void log(LogCallSite & site, const char * format, const Args & ... args) noexcept
+  {
+    static_assert(
+      sizeof...(Args) <= LogRecord::MAX_ARGUMENTS,
+      "Too many arguments for a real-time log record");
+    std::uint64_t suppressed = 0;
+    if (!checkRate(site, suppressed)) {
+      return;
+    }
+    std::size_t position;
+    Cell * cell = beginPush(position);
+    if (cell == nullptr) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    LogRecord & record = cell->record;
+    record.format = format;
+    record.severity = site.severity;
+    record.suppressed = suppressed;
+    record.argument_count = 0;
+    record.string_length = 0;
+    int expand[] = {0, (addArgument(record, args), 0)...};
+    static_cast<void>(expand);
+    endPush(cell, position);
+  }
+
+  /**
+   * @brief Formats and forwards every queued record, called by the background thread
+   *
+   * @return std::size_t: Number of records forwarded
+   */
+  std::size_t drain();
+
+  /**
+   * @brief Number of records dropped because the queue was full
+   */
+  std::uint64_t getDroppedCount() const
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Formats a record the same way as it is forwarded to rclcpp
+   */
+  static std::string format(const LogRecord & record);
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    LogRecord record;
+  };
+
+  static bool checkRate(LogCallSite & site, std::uint64_t & suppressed) noexcept;
+  Cell * beginPush(std::size_t & position) noexcept;
+  void endPush(Cell * cell, std::size_t position) noexcept;
+
+  template<typename T>
+  static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+  fillArgument(LogRecord &, LogArgument & argument, const T & value) noexcept
+  {
+    argument.type = LogArgument::Type::SIGNED;
+    argument.signed_value = value;
+  }
+
+  template<typename T>
+  static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+  fillArgument(LogRecord &, LogArgument & argument, const T & value) noexcept
+  {
+    argument.type = LogArgument::Type::UNSIGNED;
+    argument.unsigned_value = value;
+  }
+
+  template<typename T>
+  static typename std::enable_if<std::is_enum<T>::value>::type
+  fillArgument(LogRecord &, LogArgument & argument, const T & value) noexcept
+  {
+    argument.type = LogArgument::Type::SIGNED;
+    argument.signed_value = static_cast<std::int64_t>(value);
+  }
+
+  template<typename T>
+  static typename std::enable_if<std::is_floating_point<T>::value>::type
+  fillArgument(LogRecord &, LogArgument & argument, const T & value) noexcept
+  {
+    argument.type = LogArgument::Type::FLOATING;
+    argument.floating_value = value;
+  }
+
+  template<typename T>
+  static typename std::enable_if<std::is_pointer<T>::value &&
+    !std::is_same<typename std::decay<typename std::remove_pointer<T>::type>::type,
+    char>::value>::type
+  fillArgument(LogRecord &, LogArgument & argument, const T & value) noexcept
+  {
+    argument.type = LogArgument::Type::POINTER;
+    argument.pointer_value = static_cast<const void *>(value);
+  }
+
+  static void fillArgument(LogRecord & record, LogArgument & argument, const char * value) noexcept;
+
+  static void fillArgument(
+    LogRecord & record, LogArgument & argument,
+    const std::string & value) noexcept
+  {
+    fillArgument(record, argument, value.c_str());
+  }
+
+  template<typename T>
+  static void addArgument(LogRecord & record, const T & value) noexcept
+  {
+    fillArgument(record, record.arguments[record.argument_count], value);
+    record.argument_count++;
+  }
+
+  rclcpp::Logger logger_;
+  std::unique_ptr<Cell[]> cells_;
+  const std::size_t mask_;
+  std::atomic<std::size_t> enqueue_position_ {0};
+  std::atomic<std::size_t> dequeue_position_ {0};
+  std::atomic<std::uint64_t> dropped_ {0};
+  std::uint64_t reported_dropped_ = 0;
+};
+}  // namespace kroshu_ros2_core
+
+#define KROSHU_RT_LOG_IMPL(rt_logger, severity, min_interval_ms, ...) \
+  do { \
+    static ::kroshu_ros2_core::LogCallSite kroshu_rt_log_call_site( \
+      severity, static_cast<std::int64_t>(min_interval_ms) * 1000000); \
+    (rt_logger).log(kroshu_rt_log_call_site, "" __VA_ARGS__); \
+  } while (0)
+
+#define KROSHU_RT_LOG_DEBUG(rt_logger, ...) \
+  KROSHU_RT_LOG_IMPL(rt_logger, ::kroshu_ros2_core::LogSeverity::DEBUG, 0, __VA_ARGS__)
+#define KROSHU_RT_LOG_INFO(rt_logger, ...) \
+  KROSHU_RT_LOG_IMPL(rt_logger, ::kroshu_ros2_core::LogSeverity::INFO, 0, __VA_ARGS__)
+#define KROSHU_RT_LOG_WARN(rt_logger, ...) \
+  KROSHU_RT_LOG_IMPL(rt_logger, ::kroshu_ros2_core::LogSeverity::WARN, 0, __VA_ARGS__)
+#define KROSHU_RT_LOG_ERROR(rt_logger, ...) \
+  KROSHU_RT_LOG_IMPL(rt_logger, ::kroshu_ros2_core::LogSeverity::ERROR, 0, __VA_ARGS__)
+
+/**
+ * Rate-limited variants: the call site logs at most once per min_interval_ms,
+ *  the number of suppressed records is reported with the next forwarded one.
+ */
+#define KROSHU_RT_LOG_WARN_THROTTLE(rt_logger, min_interval_ms, ...) \
+  KROSHU_RT_LOG_IMPL( \
+    rt_logger, ::kroshu_ros2_core::LogSeverity::WARN, min_interval_ms, __VA_ARGS__)
+#define KROSHU_RT_LOG_ERROR_THROTTLE(rt_logger, min_interval_ms, ...) \
+  KROSHU_RT_LOG_IMPL( \
+    rt_logger, ::kroshu_ros2_core::LogSeverity::ERROR, min_interval_ms, __VA_ARGS__)
+
+#endif  // KROSHU_ROS2_CORE__REALTIMELOGGER_HPP_
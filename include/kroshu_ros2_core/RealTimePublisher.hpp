@@ -0,0 +1,236 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__REALTIMEPUBLISHER_HPP_
+#define KROSHU_ROS2_CORE__REALTIMEPUBLISHER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Activation interface of real-time publishers, used by ROS2BaseLCNode
+ *  to follow the lifecycle state of the node
+ */
+class RealTimePublisherBase
+{
+public:
+  virtual ~RealTimePublisherBase() = default;
+
+  void activate()
+  {
+    {
+      std::lock_guard<std::mutex> lock(activation_mutex_);
+      activation_count_.fetch_add(1, std::memory_order_relaxed);
+      active_.store(true, std::memory_order_release);
+    }
+    activation_cv_.notify_all();
+  }
+
+  void deactivate()
+  {
+    active_.store(false, std::memory_order_release);
+  }
+
+  bool isActive() const
+  {
+    return active_.load(std::memory_order_acquire);
+  }
+
+protected:
+  /**
+   * @brief Blocks the calling thread until the publisher is activated or stopped,
+   *  used by the drain thread
+   */
+  void waitForActivation()
+  {
+    std::unique_lock<std::mutex> lock(activation_mutex_);
+    activation_cv_.wait(lock, [this]() {return isStopped() || isActive();});
+  }
+
+  /**
+   * @brief Wakes up and stops the drain thread
+   */
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(activation_mutex_);
+      stopped_.store(true, std::memory_order_release);
+    }
+    activation_cv_.notify_all();
+  }
+
+  bool isStopped() const
+  {
+    return stopped_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Number of activations, identifies the active period a message belongs to
+   */
+  std::uint64_t getActivationCount() const
+  {
+    return activation_count_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<std::uint64_t> activation_count_ {0};
+  std::atomic_bool active_ {false};
+  std::atomic_bool stopped_ {false};
+  std::mutex activation_mutex_;
+  std::condition_variable activation_cv_;
+};
+
+/**
+ * @brief Publisher that can be used from real-time threads
+ *
+ * The real-time thread fills a preallocated message slot and commits it,
+ *  the handoff is a single lock-free state change, nothing is allocated or locked.
+ * A background thread polls the slot while the publisher is active, copies the committed message
+ *  and publishes the copy, so the middleware is never called from the real-time thread.
+ * While the publisher is inactive, the background thread is blocked until the activation.
+ * Messages are only accepted while the publisher is active. Publishers created with
+ *  ROS2BaseLCNode::createRealTimePublisher() are active while the node is active.
+ *
+ * Usage in the real-time loop:
+ *  if (auto msg = publisher->beginMessage()) { msg->data = value; publisher->commitMessage(); }
+ */
+template<typename MessageT>
+class RealTimePublisher : public RealTimePublisherBase
+{
+public:
+  /**
+   * @param publisher: Publisher used by the background thread
+   * @param prototype: Initial content of the slot, resize the arrays of the message here,
+   *  so that filling them in the real-time thread does not allocate
+   * @param poll_period: Period of the background thread checking the slot while active
+   */
+  explicit RealTimePublisher(
+    typename rclcpp::Publisher<MessageT>::SharedPtr publisher,
+    const MessageT & prototype = MessageT(),
+    std::chrono::microseconds poll_period = std::chrono::microseconds(500))
+  : publisher_(publisher), message_(prototype), published_message_(prototype),
+    poll_period_(poll_period)
+  {
+    thread_ = std::thread([this]() {run();});
+  }
+
+  ~RealTimePublisher() override
+  {
+    stop();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  RealTimePublisher(const RealTimePublisher &) = delete;
+  RealTimePublisher & operator=(const RealTimePublisher &) = delete;
+
+  /**
+   * @brief Returns the message slot to fill, real-time safe
+   *
+   * The slot keeps the content of the previous message.
+   *
+   * @return nullptr, if the publisher is inactive or the previous message is still
+   *  being published, in the latter case the message is counted as dropped
+   */
+  MessageT * beginMessage()
+  {
+    if (!isActive()) {
+      return nullptr;
+    }
+    auto expected = SlotState::IDLE;
+    if (!state_.compare_exchange_strong(
+        expected, SlotState::FILLING,
+        std::memory_order_acquire))
+    {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    message_activation_ = getActivationCount();
+    return &message_;
+  }
+
+  /**
+   * @brief Hands the filled slot over to the background thread, real-time safe
+   */
+  void commitMessage()
+  {
+    state_.store(SlotState::READY, std::memory_order_release);
+  }
+
+  /**
+   * @brief Releases the slot without publishing, real-time safe
+   */
+  void abortMessage()
+  {
+    state_.store(SlotState::IDLE, std::memory_order_release);
+  }
+
+  std::uint64_t getDroppedCount() const
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+private:
+  enum class SlotState : std::uint8_t
+  {
+    IDLE,
+    FILLING,
+    READY,
+  };
+
+  void run()
+  {
+    while (!isStopped()) {
+      if (state_.load(std::memory_order_acquire) != SlotState::READY) {
+        if (isActive()) {
+          std::this_thread::sleep_for(poll_period_);
+        } else {
+          waitForActivation();
+        }
+        continue;
+      }
+      // The copy reuses the capacity of the previous one, the slot is released before publishing
+      published_message_ = message_;
+      auto message_activation = message_activation_;
+      state_.store(SlotState::IDLE, std::memory_order_release);
+      // Messages committed while the publisher was being deactivated are dropped,
+      //  also if the thread only sees them after the next activation
+      if (isActive() && message_activation == getActivationCount()) {
+        publisher_->publish(published_message_);
+      }
+    }
+  }
+
+  typename rclcpp::Publisher<MessageT>::SharedPtr publisher_;
+  MessageT message_;
+  std::uint64_t message_activation_ = 0;
+  MessageT published_message_;
+  const std::chrono::microseconds poll_period_;
+  std::atomic<SlotState> state_ {SlotState::IDLE};
+  std::atomic<std::uint64_t> dropped_ {0};
+  std::thread thread_;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__REALTIMEPUBLISHER_HPP_
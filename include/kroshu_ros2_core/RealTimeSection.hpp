@@ -0,0 +1,64 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__REALTIMESECTION_HPP_
+#define KROSHU_ROS2_CORE__REALTIMESECTION_HPP_
+
+// Defined by the kroshu_rt_checks library, null if it is not loaded
+extern "C" {
+void kroshu_rt_section_enter() __attribute__((weak));
+void kroshu_rt_section_exit() __attribute__((weak));
+}
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Marks the enclosing scope as real-time
+ *
+ * The checks are opt-in: without the kroshu_rt_checks library the guard costs one branch.
+ * If the library is preloaded (LD_PRELOAD=libkroshu_rt_checks.so), heap allocations
+ *  and blocking calls made by the thread while a section is active are reported
+ *  according to the KROSHU_RT_CHECKS environment variable:
+ *  - count (default): violations are counted and summarized at exit
+ *  - backtrace: every violation is printed with a backtrace
+ *  - abort: the first violation is printed with a backtrace and the process is aborted
+ */
+class RealTimeSection
+{
+public:
+  RealTimeSection()
+  {
+    if (kroshu_rt_section_enter != nullptr) {
+      kroshu_rt_section_enter();
+    }
+  }
+
+  ~RealTimeSection()
+  {
+    if (kroshu_rt_section_exit != nullptr) {
+      kroshu_rt_section_exit();
+    }
+  }
+
+  RealTimeSection(const RealTimeSection &) = delete;
+  RealTimeSection & operator=(const RealTimeSection &) = delete;
+};
+}  // namespace kroshu_ros2_core
+
+#define KROSHU_RT_SECTION_CONCAT_IMPL(a, b) a ## b
+#define KROSHU_RT_SECTION_CONCAT(a, b) KROSHU_RT_SECTION_CONCAT_IMPL(a, b)
+#define KROSHU_RT_SECTION() \
+  ::kroshu_ros2_core::RealTimeSection KROSHU_RT_SECTION_CONCAT(kroshu_rt_section_, __LINE__)
+
+#endif  // KROSHU_ROS2_CORE__REALTIMESECTION_HPP_
@@ -0,0 +1,74 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__REALTIMETOOLS_HPP_
+#define KROSHU_ROS2_CORE__REALTIMETOOLS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Sets the SCHED_FIFO policy with the given priority for the calling thread
+ *
+ * @param priority: Priority between 1 and 99
+ * @return False, if the scheduler could not be set, errno describes the reason
+ */
+bool setThreadFifoPriority(int priority);
+
+/**
+ * @brief Pins the calling thread to the given CPUs
+ *
+ * Threads created afterwards by the calling thread inherit the affinity.
+ *
+ * @param cpus: Indices of the allowed CPUs, nothing happens if it is empty
+ * @return False, if the affinity could not be set, errno describes the reason
+ */
+bool setThreadAffinity(const std::vector<std::int64_t> & cpus);
+
+/**
+ * @brief Locks all current and future pages of the process into RAM
+ *
+ * @return False, if mlockall failed, errno describes the reason
+ */
+bool lockMemory();
+
+/**
+ * @brief Touches the given amount of stack below the current frame so that it is mapped
+ *
+ * Has to be called from the thread whose stack should be prefaulted,
+ *  the size must be well below the stack limit of the thread.
+ */
+void prefaultStack(std::size_t size);
+
+/**
+ * @brief Maps the given amount of heap and keeps it in the allocator after freeing
+ *
+ * Disables heap trimming and mmap-based allocations, so that later allocations
+ *  are served from the prefaulted arena instead of new pages.
+ *
+ * @return False, if the allocator could not be configured or the memory could not be allocated
+ */
+bool prefaultHeap(std::size_t size);
+
+/**
+ * @brief Formats a CPU list for logging, e.g. "[2, 3]"
+ */
+std::string cpuListToString(const std::vector<std::int64_t> & cpus);
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__REALTIMETOOLS_HPP_
@@ -0,0 +1,153 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__SHAREDSTATUSBLOCK_HPP_
+#define KROSHU_ROS2_CORE__SHAREDSTATUSBLOCK_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "kroshu_ros2_core/ControlMode.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Status of the robot manager handed over to the control loop
+ */
+struct RobotStatus
+{
+  bool is_configured = false;
+  ControlMode control_mode = ControlMode::UNSPECIFIED_CONTROL_MODE;
+
+  /**
+   * @brief Incremented by every write of the robot manager
+   */
+  std::uint64_t heartbeat = 0;
+
+  /**
+   * @brief Steady clock time of the last write, the processes must run on the same host
+   */
+  std::int64_t heartbeat_time_ns = 0;
+};
+
+/**
+ * @brief Layout of the shared memory object, only accessed through the writer and the reader
+ *
+ * The fields are protected by a seqlock: the sequence is odd while a write is in progress
+ *  and readers retry or give up if it changed during their read.
+ * All fields are lock-free atomics, so the block works across processes.
+ */
+struct SharedStatusLayout
+{
+  static constexpr std::uint32_t MAGIC = 0x4B525353;  // "KRSS"
+  static constexpr std::uint32_t VERSION = 1;
+
+  std::atomic<std::uint32_t> magic;
+  std::atomic<std::uint32_t> version;
+  std::atomic<std::uint64_t> sequence;
+  std::atomic<std::uint32_t> is_configured;
+  std::atomic<std::uint32_t> control_mode;
+  std::atomic<std::uint64_t> heartbeat;
+  std::atomic<std::int64_t> heartbeat_time_ns;
+};
+
+/**
+ * @brief Writes the status into a POSIX shared memory object, used by the robot manager
+ *
+ * The object is created if it does not exist yet and kept at destruction,
+ *  so a restarted writer continues the same block and the readers do not have to reattach.
+ * Write the status periodically even if it did not change, as the reader uses the
+ *  heartbeat as a watchdog. Writing is wait-free, there must be only one writer.
+ */
+class SharedStatusWriter
+{
+public:
+  /**
+   * @param name: Name of the shared memory object, starting with a slash
+   * @throw std::runtime_error if the object could not be created or mapped
+   */
+  explicit SharedStatusWriter(const std::string & name);
+  ~SharedStatusWriter();
+
+  SharedStatusWriter(const SharedStatusWriter &) = delete;
+  SharedStatusWriter & operator=(const SharedStatusWriter &) = delete;
+
+  /**
+   * @brief Publishes the status, increments the heartbeat and stamps it with the current time
+   */
+  void write(bool is_configured, ControlMode control_mode);
+
+private:
+  const std::string name_;
+  SharedStatusLayout * layout_ = nullptr;
+  std::uint64_t heartbeat_ = 0;
+};
+
+/**
+ * @brief Reads the status written by SharedStatusWriter, used by the control loop
+ *
+ * The reader can be created before the robot manager: attach() is retried from
+ *  a non real-time thread until the block exists, read() can be called meanwhile.
+ * read() must be called from a single thread.
+ */
+class SharedStatusReader
+{
+public:
+  /**
+   * @param watchdog_timeout: The status is considered lost if the heartbeat is older
+   */
+  SharedStatusReader(const std::string & name, std::chrono::nanoseconds watchdog_timeout);
+  ~SharedStatusReader();
+
+  SharedStatusReader(const SharedStatusReader &) = delete;
+  SharedStatusReader & operator=(const SharedStatusReader &) = delete;
+
+  /**
+   * @brief Maps the shared memory object if it exists and has the expected version,
+   *  not real-time safe
+   *
+   * @return true if the block is mapped, including previous successful calls
+   */
+  bool attach();
+
+  /**
+   * @brief Reads the status wait-free, real-time safe
+   *
+   * If the writer is in the middle of an update, the previous consistent status is returned.
+   * If the block is not attached or the heartbeat is older than the watchdog timeout,
+   *  the status is returned with is_configured set to false, so the hardware is not touched
+   *  while the robot manager is missing.
+   */
+  RobotStatus read();
+
+  /**
+   * @brief Whether the last read() found an attached block with a fresh heartbeat
+   */
+  bool isAlive() const
+  {
+    return alive_;
+  }
+
+private:
+  const std::string name_;
+  const std::chrono::nanoseconds watchdog_timeout_;
+  std::atomic<const SharedStatusLayout *> layout_ {nullptr};
+  RobotStatus last_status_;
+  bool alive_ = false;
+};
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__SHAREDSTATUSBLOCK_HPP_
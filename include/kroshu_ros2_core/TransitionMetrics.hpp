@@ -0,0 +1,81 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KROSHU_ROS2_CORE__TRANSITIONMETRICS_HPP_
+#define KROSHU_ROS2_CORE__TRANSITIONMETRICS_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "diagnostic_msgs/msg/diagnostic_status.hpp"
+
+namespace kroshu_ros2_core
+{
+/**
+ * @brief Resources used by one lifecycle transition, including the work of the subclass
+ */
+struct TransitionMetrics
+{
+  std::string transition;
+  std::string result;
+  std::chrono::nanoseconds duration {0};
+
+  /**
+   * @brief Heap allocations made by the thread running the transition,
+   *  -1 if the kroshu_rt_checks library is not preloaded
+   */
+  std::int64_t allocations = -1;
+
+  /**
+   * @brief Change of the bytes allocated on the heap by the whole process
+   */
+  std::int64_t heap_delta_bytes = 0;
+
+  /**
+   * @brief Change of the resident set size of the process
+   */
+  std::int64_t rss_delta_bytes = 0;
+};
+
+/**
+ * @brief Samples time and resource usage at construction and at stop()
+ *
+ * The samples are taken without allocating, so the probe does not distort the counts.
+ */
+class TransitionProbe
+{
+public:
+  TransitionProbe();
+
+  /**
+   * @brief Takes the second sample and returns the difference
+   */
+  TransitionMetrics stop(const std::string & transition, const std::string & result) const;
+
+private:
+  std::int64_t rss_bytes_;
+  std::int64_t heap_bytes_;
+  std::int64_t allocations_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Converts the metrics to a diagnostic status named <node_name>: <transition>
+ */
+diagnostic_msgs::msg::DiagnosticStatus toDiagnosticStatus(
+  const TransitionMetrics & metrics, const std::string & node_name);
+}  // namespace kroshu_ros2_core
+
+#endif  // KROSHU_ROS2_CORE__TRANSITIONMETRICS_HPP_
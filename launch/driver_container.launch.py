@@ -0,0 +1,106 @@
+# Copyright 2026 KUKA Hungaria Kft.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Load a driver stack into a single component container.
+
+The components are listed in the YAML file given in the stack_file argument:
+
+components:
+  - package: <package of the component library>
+    plugin: <namespace>::<NodeClass>
+    name: <node name, optional>
+    namespace: <node namespace, optional>
+    parameters: [<parameter file path or dictionary>, ...]  # optional
+    remappings: [[<from>, <to>], ...]  # optional
+
+All nodes share one process, so one DDS participant and the executor of the container.
+"""
+
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, OpaqueFunction
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+import yaml
+
+CONTAINER_EXECUTABLES = {
+    'single_threaded': 'component_container',
+    'multi_threaded': 'component_container_mt',
+    'isolated': 'component_container_isolated',
+}
+
+
+def load_components(stack_file, use_intra_process_comms):
+    """Create the composable node descriptions listed in the stack file."""
+    with open(stack_file, 'r') as file:
+        stack = yaml.safe_load(file) or {}
+    components = []
+    for component in stack.get('components', []):
+        optional = {
+            key: component[key]
+            for key in ('name', 'namespace', 'parameters')
+            if key in component
+        }
+        if 'remappings' in component:
+            optional['remappings'] = [tuple(pair) for pair in component['remappings']]
+        components.append(
+            ComposableNode(
+                package=component['package'],
+                plugin=component['plugin'],
+                extra_arguments=[{'use_intra_process_comms': use_intra_process_comms}],
+                **optional,
+            )
+        )
+    return components
+
+
+def launch_setup(context, *args, **kwargs):
+    """Create the container with the components of the stack."""
+    executor = LaunchConfiguration('executor').perform(context)
+    if executor not in CONTAINER_EXECUTABLES:
+        raise RuntimeError(
+            'Unknown executor: ' + executor + ', use one of ' + ', '.join(CONTAINER_EXECUTABLES)
+        )
+    use_intra_process_comms = (
+        LaunchConfiguration('use_intra_process_comms').perform(context).lower() == 'true'
+    )
+    container = ComposableNodeContainer(
+        name=LaunchConfiguration('container_name'),
+        namespace=LaunchConfiguration('namespace'),
+        package='rclcpp_components',
+        executable=CONTAINER_EXECUTABLES[executor],
+        composable_node_descriptions=load_components(
+            LaunchConfiguration('stack_file').perform(context), use_intra_process_comms
+        ),
+        output='screen',
+    )
+    return [container]
+
+
+def generate_launch_description():
+    launch_arguments = [
+        DeclareLaunchArgument(
+            'stack_file', description='YAML file listing the components to load'
+        ),
+        DeclareLaunchArgument('container_name', default_value='driver_container'),
+        DeclareLaunchArgument('namespace', default_value=''),
+        DeclareLaunchArgument(
+            'executor',
+            default_value='multi_threaded',
+            description='Executor of the container: ' + ', '.join(CONTAINER_EXECUTABLES),
+        ),
+        DeclareLaunchArgument('use_intra_process_comms', default_value='true'),
+    ]
+    return LaunchDescription(launch_arguments + [OpaqueFunction(function=launch_setup)])
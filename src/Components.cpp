@@ -0,0 +1,55 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kroshu_ros2_core/Components.hpp"
+
+namespace kroshu_ros2_core
+{
+namespace
+{
+thread_local const rclcpp::NodeOptions * pending_options = nullptr;
+}  // namespace
+
+ComponentOptionsScope::ComponentOptionsScope(const rclcpp::NodeOptions & options)
+: previous_(pending_options)
+{
+  pending_options = &options;
+}
+
+ComponentOptionsScope::~ComponentOptionsScope()
+{
+  // The scope is released in the constructor of the adapter,
+  //  only a failed construction ends up here unreleased
+  release();
+}
+
+void ComponentOptionsScope::release()
+{
+  if (!released_) {
+    pending_options = previous_;
+    released_ = true;
+  }
+}
+
+rclcpp::NodeOptions ComponentOptionsScope::resolve(const rclcpp::NodeOptions & options)
+{
+  if (pending_options == nullptr) {
+    return options;
+  }
+  // Only the first node constructed in the scope gets the options of the container
+  rclcpp::NodeOptions result = *pending_options;
+  pending_options = nullptr;
+  return result;
+}
+}  // namespace kroshu_ros2_core
@@ -0,0 +1,148 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+
+#include "kroshu_ros2_core/ControlLoopStatistics.hpp"
+
+namespace kroshu_ros2_core
+{
+constexpr std::size_t LatencyHistogram::SUB_BUCKET_COUNT;
+constexpr std::size_t LatencyHistogram::BUCKET_COUNT;
+constexpr std::size_t ControlLoopStatistics::PHASE_COUNT;
+
+double LatencyHistogram::Snapshot::mean() const
+{
+  if (count == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(sum_ns) / static_cast<double>(count);
+}
+
+std::int64_t LatencyHistogram::Snapshot::quantile(double quantile) const
+{
+  if (count == 0) {
+    return 0;
+  }
+  quantile = std::min(std::max(quantile, 0.0), 1.0);
+  auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count));
+  std::uint64_t cumulated = 0;
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+    cumulated += buckets[i];
+    if (cumulated > rank || cumulated == count) {
+      if (i == BUCKET_COUNT - 1) {
+        // The last bucket also counts the samples above its range
+        return max_ns;
+      }
+      auto upper_bound_ns = static_cast<std::int64_t>(bucketUpperBound(i) * 1000);
+      return std::min(upper_bound_ns, max_ns);
+    }
+  }
+  return max_ns;
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t duration_us)
+{
+  if (duration_us < SUB_BUCKET_COUNT) {
+    return static_cast<std::size_t>(duration_us);
+  }
+  // The two bits after the most significant bit select the sub-bucket
+  auto msb = static_cast<std::size_t>(63 - __builtin_clzll(duration_us));
+  auto sub_bucket = static_cast<std::size_t>((duration_us >> (msb - 2)) & (SUB_BUCKET_COUNT - 1));
+  return std::min((msb - 1) * SUB_BUCKET_COUNT + sub_bucket, BUCKET_COUNT - 1);
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index)
+{
+  if (index < SUB_BUCKET_COUNT) {
+    return index + 1;
+  }
+  std::size_t msb = index / SUB_BUCKET_COUNT + 1;
+  std::uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+  std::uint64_t width = std::uint64_t{1} << (msb - 2);
+  return (std::uint64_t{1} << msb) + (sub_bucket + 1) * width;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+  std::int64_t duration_ns = std::max<std::int64_t>(duration.count(), 0);
+  auto & bucket = buckets_[bucketIndex(static_cast<std::uint64_t>(duration_ns / 1000))];
+
+  // Single writer: plain load-store pairs are enough, no locked instructions are needed
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  sum_ns_.store(sum_ns_.load(std::memory_order_relaxed) + duration_ns, std::memory_order_relaxed);
+  if (duration_ns > max_ns_.load(std::memory_order_relaxed)) {
+    max_ns_.store(duration_ns, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+  Snapshot snapshot;
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  snapshot.count = count_.load(std::memory_order_relaxed);
+  snapshot.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+  snapshot.max_ns = max_ns_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+ControlLoopStatistics::ControlLoopStatistics(
+  std::chrono::nanoseconds period,
+  std::chrono::nanoseconds overrun_tolerance)
+: period_(period), overrun_tolerance_(overrun_tolerance)
+{
+}
+
+void ControlLoopStatistics::recordCycle(
+  std::chrono::steady_clock::time_point cycle_start,
+  std::chrono::steady_clock::time_point compute_start,
+  std::chrono::steady_clock::time_point cycle_end)
+{
+  recordPhase(Phase::COMPUTE, cycle_end - compute_start);
+  if (!first_cycle_) {
+    auto cycle_time = cycle_start - last_cycle_start_;
+    auto jitter = cycle_time - period_;
+    recordPhase(Phase::WAKE_UP_JITTER, jitter < jitter.zero() ? -jitter : jitter);
+    recordPhase(Phase::CYCLE, cycle_time);
+    if (cycle_time > period_ + overrun_tolerance_) {
+      overruns_.store(overruns_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  }
+  first_cycle_ = false;
+  last_cycle_start_ = cycle_start;
+}
+
+const char * ControlLoopStatistics::phaseName(Phase phase)
+{
+  switch (phase) {
+    case Phase::WAKE_UP_JITTER:
+      return "wake_up_jitter";
+    case Phase::READ:
+      return "read";
+    case Phase::UPDATE:
+      return "update";
+    case Phase::WRITE:
+      return "write";
+    case Phase::CYCLE:
+      return "cycle";
+    case Phase::COMPUTE:
+      return "compute";
+    default:
+      return "unknown";
+  }
+}
+}  // namespace kroshu_ros2_core
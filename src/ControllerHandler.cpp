@@ -11,6 +11,8 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <algorithm>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <utility>
@@ -19,6 +21,34 @@
 
 namespace kroshu_ros2_core
 {
+namespace
+{
+bool compareNames(const std::string * lhs, const std::string * rhs)
+{
+  return *lhs < *rhs;
+}
+
+void addController(std::vector<const std::string *> & controllers, const std::string & controller)
+{
+  auto controllers_it = std::find_if(
+    controllers.begin(), controllers.end(),
+    [&controller](const std::string * name) {return *name == controller;});
+  if (controllers_it == controllers.end()) {
+    controllers.push_back(&controller);
+  }
+}
+
+// Assigns the existing strings instead of recreating them, so their capacity is reused
+void copyNames(
+  const std::vector<const std::string *> & names, std::vector<std::string> & names_out)
+{
+  names_out.resize(names.size());
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    names_out[i] = *names[i];
+  }
+}
+}  // namespace
+
 ControllerHandler::ControllerHandler(std::vector<std::string> fixed_controllers)
 : fixed_controllers_(fixed_controllers.begin(), fixed_controllers.end())
 {}
@@ -66,7 +96,17 @@ bool ControllerHandler::UpdateControllerName(
 std::pair<std::vector<std::string>, std::vector<std::string>>
 ControllerHandler::GetControllersForSwitch(ControlMode new_control_mode)
 {
-  if (control_mode_map_.find(new_control_mode) == control_mode_map_.end()) {
+  std::pair<std::vector<std::string>, std::vector<std::string>> controllers;
+  GetControllersForSwitch(new_control_mode, controllers.first, controllers.second);
+  return controllers;
+}
+
+void ControllerHandler::GetControllersForSwitch(
+  ControlMode new_control_mode, std::vector<std::string> & activate_controllers_out,
+  std::vector<std::string> & deactivate_controllers_out)
+{
+  auto control_mode_controllers_it = control_mode_map_.find(new_control_mode);
+  if (control_mode_controllers_it == control_mode_map_.end()) {
     // Not valid control mode, through error
     throw std::out_of_range("Attribute new_control_mode is out of range");
   }
@@ -76,47 +116,40 @@ ControllerHandler::GetControllersForSwitch(ControlMode new_control_mode)
   }
 
   // Set controllers wich should be activated and deactivated
-  activate_controllers_.clear();
-  auto control_mode_controllers = control_mode_map_.at(new_control_mode);
-  activate_controllers_.insert(control_mode_controllers.standard_controller);
+  activate_names_.clear();
+  const auto & control_mode_controllers = control_mode_controllers_it->second;
+  addController(activate_names_, control_mode_controllers.standard_controller);
   if (!control_mode_controllers.impedance_controller.empty()) {
-    activate_controllers_.insert(control_mode_controllers.impedance_controller);
+    addController(activate_names_, control_mode_controllers.impedance_controller);
   }
+  for (const auto & controller : fixed_controllers_) {
+    addController(activate_names_, controller);
+  }
+  std::sort(activate_names_.begin(), activate_names_.end(), compareNames);
 
-  activate_controllers_.insert(fixed_controllers_.begin(), fixed_controllers_.end());
-
-  deactivate_controllers_ = active_controllers_;
-
-
-  // Goes through every controllers that should be activated
-  for (auto activate_controllers_it = activate_controllers_.begin();
-    activate_controllers_it != activate_controllers_.end(); )
-  {
-    // Finds the controller in the deactivate controllers
-    auto deactivate_controllers_it =
-      deactivate_controllers_.find(*activate_controllers_it);
-    if (deactivate_controllers_it != deactivate_controllers_.end()) {
-      // Delete those controllers wich not need to be activated or deactivated.
-      activate_controllers_it = activate_controllers_.erase(activate_controllers_it);
-      deactivate_controllers_.erase(deactivate_controllers_it);
+  // Active controllers that are also needed in the new mode are neither activated nor deactivated
+  deactivate_names_.clear();
+  for (const auto & controller : active_controllers_) {
+    auto activate_names_it = std::find_if(
+      activate_names_.begin(), activate_names_.end(),
+      [&controller](const std::string * name) {return *name == controller;});
+    if (activate_names_it != activate_names_.end()) {
+      activate_names_.erase(activate_names_it);
     } else {
-      ++activate_controllers_it;
+      deactivate_names_.push_back(&controller);
     }
   }
 
-  return std::make_pair(
-    std::vector<std::string>(
-      activate_controllers_.begin(),
-      activate_controllers_.end()),
-    std::vector<std::string>(
-      deactivate_controllers_.begin(),
-      deactivate_controllers_.end()));
+  copyNames(activate_names_, activate_controllers_);
+  copyNames(deactivate_names_, deactivate_controllers_);
+  activate_controllers_out.assign(activate_controllers_.begin(), activate_controllers_.end());
+  deactivate_controllers_out.assign(deactivate_controllers_.begin(), deactivate_controllers_.end());
 }
 
 std::vector<std::string> ControllerHandler::GetControllersForDeactivation()
 {
-  deactivate_controllers_ = active_controllers_;
-  return std::vector<std::string>(deactivate_controllers_.begin(), deactivate_controllers_.end());
+  deactivate_controllers_.assign(active_controllers_.begin(), active_controllers_.end());
+  return deactivate_controllers_;
 }
 
 void ControllerHandler::ApproveControllerActivation()
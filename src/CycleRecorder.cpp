@@ -0,0 +1,210 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "kroshu_ros2_core/CycleRecorder.hpp"
+
+namespace kroshu_ros2_core
+{
+namespace
+{
+constexpr char kSegmentMagic[8] = {'K', 'R', 'S', 'H', 'C', 'Y', 'C', '1'};
+constexpr std::size_t kSegmentHeaderSize = sizeof(kSegmentMagic) + sizeof(std::uint64_t);
+constexpr std::size_t kFrameHeaderSize =
+  sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::int64_t);
+constexpr std::uint32_t kEndMarker = 0;
+}  // namespace
+
+void CycleRecorderOptions::setHistory(std::chrono::seconds history, double cycle_rate)
+{
+  double frames = static_cast<double>(history.count()) * cycle_rate;
+  auto total_size = static_cast<std::size_t>(frames * (max_frame_size + kFrameHeaderSize));
+  // One segment is being overwritten at any time, so the others have to hold the history
+  std::size_t full_segments = std::max<std::size_t>(segment_count, 2) - 1;
+  segment_size = total_size / full_segments + kSegmentHeaderSize + sizeof(kEndMarker);
+}
+
+CycleRecorder::CycleRecorder(const CycleRecorderOptions & options)
+: options_(options), slots_(std::max<std::size_t>(options.queue_length, 1) + 1)
+{
+  if (options_.segment_size < kSegmentHeaderSize + kFrameHeaderSize + sizeof(kEndMarker)) {
+    throw std::runtime_error("Segment size is too small");
+  }
+  for (auto & slot : slots_) {
+    slot.data.reserve(options_.max_frame_size);
+  }
+
+  segments_.resize(std::max<std::size_t>(options_.segment_count, 1));
+  for (std::size_t i = 0; i < segments_.size(); ++i) {
+    std::string path = options_.directory + "/" + options_.prefix + "_" + std::to_string(i) +
+      ".bin";
+    auto & segment = segments_[i];
+    segment.fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (segment.fd < 0) {
+      throw std::runtime_error("Could not create " + path + ": " + strerror(errno));
+    }
+    // Allocate the disk space in advance, so that writing never has to extend the file
+    int result = posix_fallocate(segment.fd, 0, static_cast<off_t>(options_.segment_size));
+    if (result != 0 && ftruncate(segment.fd, static_cast<off_t>(options_.segment_size)) != 0) {
+      throw std::runtime_error("Could not allocate " + path + ": " + strerror(result));
+    }
+    void * memory = mmap(
+      nullptr, options_.segment_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+      segment.fd, 0);
+    if (memory == MAP_FAILED) {
+      throw std::runtime_error("Could not map " + path + ": " + strerror(errno));
+    }
+    segment.memory = static_cast<std::uint8_t *>(memory);
+  }
+  startSegment(0);
+
+  writer_ = std::thread([this]() {run();});
+}
+
+CycleRecorder::~CycleRecorder()
+{
+  stop_ = true;
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  for (auto & segment : segments_) {
+    if (segment.memory != nullptr) {
+      msync(segment.memory, options_.segment_size, MS_SYNC);
+      munmap(segment.memory, options_.segment_size);
+    }
+    if (segment.fd >= 0) {
+      close(segment.fd);
+    }
+  }
+}
+
+std::vector<std::uint8_t> * CycleRecorder::beginFrame(std::int64_t stamp_ns)
+{
+  if (frozen_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  auto head = head_.load(std::memory_order_relaxed);
+  if ((head + 1) % slots_.size() == tail_.load(std::memory_order_acquire)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto & slot = slots_[head];
+  slot.stamp_ns = stamp_ns;
+  slot.sequence = next_sequence_++;
+  slot.data.clear();
+  return &slot.data;
+}
+
+void CycleRecorder::commitFrame()
+{
+  auto head = head_.load(std::memory_order_relaxed);
+  head_.store((head + 1) % slots_.size(), std::memory_order_release);
+}
+
+void CycleRecorder::freeze()
+{
+  frozen_.store(true, std::memory_order_release);
+  freeze_requested_.store(true, std::memory_order_release);
+}
+
+void CycleRecorder::unfreeze()
+{
+  frozen_.store(false, std::memory_order_release);
+}
+
+void CycleRecorder::run()
+{
+  while (!stop_) {
+    bool freeze_requested = freeze_requested_.exchange(false);
+    if (writePending() == 0) {
+      if (freeze_requested) {
+        syncSegments();
+      }
+      std::this_thread::sleep_for(options_.writer_period);
+    } else if (freeze_requested) {
+      // Frames committed before the freeze are still written
+      freeze_requested_ = true;
+    }
+  }
+  writePending();
+}
+
+std::size_t CycleRecorder::writePending()
+{
+  std::size_t count = 0;
+  auto tail = tail_.load(std::memory_order_relaxed);
+  while (tail != head_.load(std::memory_order_acquire)) {
+    writeFrame(slots_[tail]);
+    tail = (tail + 1) % slots_.size();
+    tail_.store(tail, std::memory_order_release);
+    count++;
+  }
+  return count;
+}
+
+void CycleRecorder::writeFrame(const Slot & slot)
+{
+  std::size_t frame_size = kFrameHeaderSize + slot.data.size();
+  if (slot.data.empty() ||
+    kSegmentHeaderSize + frame_size + sizeof(kEndMarker) > options_.segment_size)
+  {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (segment_offset_ + frame_size + sizeof(kEndMarker) > options_.segment_size) {
+    startSegment((current_segment_ + 1) % segments_.size());
+  }
+
+  std::uint8_t * frame = segments_[current_segment_].memory + segment_offset_;
+  auto payload_size = static_cast<std::uint32_t>(slot.data.size());
+  // The end marker is moved first, so that a reader never sees a partially written frame
+  std::memcpy(frame + frame_size, &kEndMarker, sizeof(kEndMarker));
+  std::memcpy(frame + sizeof(payload_size), &slot.sequence, sizeof(slot.sequence));
+  std::memcpy(
+    frame + sizeof(payload_size) + sizeof(slot.sequence), &slot.stamp_ns,
+    sizeof(slot.stamp_ns));
+  std::memcpy(frame + kFrameHeaderSize, slot.data.data(), slot.data.size());
+  std::memcpy(frame, &payload_size, sizeof(payload_size));
+  segment_offset_ += frame_size;
+  written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CycleRecorder::startSegment(std::size_t index)
+{
+  current_segment_ = index;
+  std::uint8_t * memory = segments_[index].memory;
+  std::memcpy(memory + kSegmentHeaderSize, &kEndMarker, sizeof(kEndMarker));
+  std::memcpy(memory, kSegmentMagic, sizeof(kSegmentMagic));
+  std::memcpy(memory + sizeof(kSegmentMagic), &generation_, sizeof(generation_));
+  generation_++;
+  segment_offset_ = kSegmentHeaderSize;
+}
+
+void CycleRecorder::syncSegments()
+{
+  for (auto & segment : segments_) {
+    msync(segment.memory, options_.segment_size, MS_SYNC);
+  }
+}
+}  // namespace kroshu_ros2_core
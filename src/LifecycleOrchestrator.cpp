@@ -0,0 +1,348 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lifecycle_msgs/msg/state.hpp"
+#include "lifecycle_msgs/msg/transition.hpp"
+
+#include "kroshu_ros2_core/LifecycleOrchestrator.hpp"
+
+using lifecycle_msgs::msg::State;
+using lifecycle_msgs::msg::Transition;
+using lifecycle_msgs::srv::ChangeState;
+using lifecycle_msgs::srv::GetState;
+
+namespace kroshu_ros2_core
+{
+namespace
+{
+const char * transitionLabel(std::uint8_t transition_id)
+{
+  switch (transition_id) {
+    case Transition::TRANSITION_CONFIGURE:
+      return "configure";
+    case Transition::TRANSITION_CLEANUP:
+      return "cleanup";
+    case Transition::TRANSITION_ACTIVATE:
+      return "activate";
+    case Transition::TRANSITION_DEACTIVATE:
+      return "deactivate";
+    default:
+      return "transition";
+  }
+}
+
+std::uint8_t transitionGoal(std::uint8_t transition_id)
+{
+  switch (transition_id) {
+    case Transition::TRANSITION_CONFIGURE:
+    case Transition::TRANSITION_DEACTIVATE:
+      return State::PRIMARY_STATE_INACTIVE;
+    case Transition::TRANSITION_CLEANUP:
+      return State::PRIMARY_STATE_UNCONFIGURED;
+    case Transition::TRANSITION_ACTIVATE:
+      return State::PRIMARY_STATE_ACTIVE;
+    default:
+      return State::PRIMARY_STATE_UNKNOWN;
+  }
+}
+}  // namespace
+
+LifecycleOrchestrator::LifecycleOrchestrator(rclcpp::Node::SharedPtr node)
+: node_(node)
+{
+}
+
+void LifecycleOrchestrator::addNode(
+  const std::string & node_name,
+  const std::vector<std::string> & dependencies)
+{
+  auto find = [this](const std::string & name) {
+      return std::find_if(
+        nodes_.begin(), nodes_.end(),
+        [&name](const ManagedNode & node) {return node.name == name;});
+    };
+  if (find(node_name) != nodes_.end()) {
+    throw std::invalid_argument("Node " + node_name + " was already added");
+  }
+
+  ManagedNode managed_node;
+  managed_node.name = node_name;
+  for (const auto & dependency : dependencies) {
+    auto it = find(dependency);
+    if (it == nodes_.end()) {
+      throw std::invalid_argument(
+              "Dependency " + dependency + " of node " + node_name + " was not added before");
+    }
+    managed_node.dependencies.push_back(static_cast<std::size_t>(it - nodes_.begin()));
+  }
+  managed_node.client = node_->create_client<ChangeState>(node_name + "/change_state");
+  managed_node.state_client = node_->create_client<GetState>(node_name + "/get_state");
+
+  for (auto dependency : managed_node.dependencies) {
+    nodes_[dependency].dependents.push_back(nodes_.size());
+  }
+  nodes_.push_back(std::move(managed_node));
+}
+
+OrchestrationResult LifecycleOrchestrator::configure(std::chrono::milliseconds deadline)
+{
+  return runForward({Transition::TRANSITION_CONFIGURE}, {Transition::TRANSITION_CLEANUP}, deadline);
+}
+
+OrchestrationResult LifecycleOrchestrator::activate(std::chrono::milliseconds deadline)
+{
+  return runForward(
+    {Transition::TRANSITION_ACTIVATE}, {Transition::TRANSITION_DEACTIVATE},
+    deadline);
+}
+
+OrchestrationResult LifecycleOrchestrator::deactivate(std::chrono::milliseconds deadline)
+{
+  return runReverse({Transition::TRANSITION_DEACTIVATE}, deadline);
+}
+
+OrchestrationResult LifecycleOrchestrator::cleanup(std::chrono::milliseconds deadline)
+{
+  return runReverse({Transition::TRANSITION_CLEANUP}, deadline);
+}
+
+OrchestrationResult LifecycleOrchestrator::bringUp(std::chrono::milliseconds deadline)
+{
+  return runForward(
+    {Transition::TRANSITION_CONFIGURE, Transition::TRANSITION_ACTIVATE},
+    {Transition::TRANSITION_CLEANUP, Transition::TRANSITION_DEACTIVATE}, deadline);
+}
+
+OrchestrationResult LifecycleOrchestrator::bringDown(std::chrono::milliseconds deadline)
+{
+  return runReverse(
+    {Transition::TRANSITION_DEACTIVATE, Transition::TRANSITION_CLEANUP},
+    deadline);
+}
+
+void LifecycleOrchestrator::logResult(const OrchestrationResult & result) const
+{
+  for (const auto & report : result.transitions) {
+    RCLCPP_INFO(
+      node_->get_logger(), "%s%s of %s %s in %.1f ms", report.rollback ? "Rollback: " : "",
+      transitionLabel(report.transition_id), report.node_name.c_str(),
+      report.success ? "succeeded" : "failed",
+      std::chrono::duration<double, std::milli>(report.duration).count());
+  }
+  if (result.deadline_exceeded) {
+    RCLCPP_ERROR(node_->get_logger(), "Lifecycle transitions exceeded the deadline");
+  } else if (!result.success) {
+    RCLCPP_ERROR(node_->get_logger(), "Lifecycle transitions failed");
+  }
+}
+
+OrchestrationResult LifecycleOrchestrator::runForward(
+  const std::vector<std::uint8_t> & transitions,
+  const std::vector<std::uint8_t> & rollback_transitions, std::chrono::milliseconds deadline)
+{
+  OrchestrationResult result;
+  auto end = std::chrono::steady_clock::now() + deadline;
+  std::vector<std::vector<std::size_t>> succeeded(transitions.size());
+  std::vector<std::size_t> timed_out;
+  std::size_t stage = 0;
+  for (; stage < transitions.size(); ++stage) {
+    if (!runTransition(
+        allNodes(), transitions[stage], false, false, end, result,
+        succeeded[stage], timed_out))
+    {
+      result.success = false;
+      break;
+    }
+  }
+  if (result.success) {
+    return result;
+  }
+
+  // Abandoned requests of the failed stage may have completed since, such nodes are rolled back too
+  // The queries only get half of the rollback deadline, so that a node still transitioning
+  //  does not use up the time of the rollback of the others
+  auto rollback_start = std::chrono::steady_clock::now();
+  auto rollback_end = rollback_start + deadline;
+  for (auto index : timed_out) {
+    auto state = queryState(index, rollback_start + deadline / 2);
+    if (state == transitionGoal(transitions[stage])) {
+      succeeded[stage].push_back(index);
+    } else if (state == State::PRIMARY_STATE_UNKNOWN) {
+      RCLCPP_WARN(
+        node_->get_logger(), "State of %s is unknown after the deadline, it is not rolled back",
+        nodes_[index].name.c_str());
+    }
+  }
+
+  // Undo the completed stages in reverse order, the failed stage included
+  for (std::size_t i = std::min(stage + 1, transitions.size()); i > 0; --i) {
+    std::vector<std::size_t> rolled_back;
+    std::vector<std::size_t> rollback_timed_out;
+    runTransition(
+      succeeded[i - 1], rollback_transitions[i - 1], true, true, rollback_end, result,
+      rolled_back, rollback_timed_out);
+  }
+  return result;
+}
+
+OrchestrationResult LifecycleOrchestrator::runReverse(
+  const std::vector<std::uint8_t> & transitions,
+  std::chrono::milliseconds deadline)
+{
+  OrchestrationResult result;
+  auto end = std::chrono::steady_clock::now() + deadline;
+  for (auto transition : transitions) {
+    std::vector<std::size_t> succeeded;
+    std::vector<std::size_t> timed_out;
+    if (!runTransition(allNodes(), transition, true, false, end, result, succeeded, timed_out)) {
+      result.success = false;
+      break;
+    }
+  }
+  return result;
+}
+
+bool LifecycleOrchestrator::runTransition(
+  const std::vector<std::size_t> & nodes, std::uint8_t transition_id, bool reverse,
+  bool rollback, std::chrono::steady_clock::time_point deadline, OrchestrationResult & result,
+  std::vector<std::size_t> & succeeded, std::vector<std::size_t> & timed_out)
+{
+  struct Request
+  {
+    std::size_t index;
+    rclcpp::Client<ChangeState>::FutureAndRequestId future;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  std::vector<bool> involved(nodes_.size(), false);
+  std::vector<bool> done(nodes_.size(), false);
+  for (auto index : nodes) {
+    involved[index] = true;
+  }
+  std::vector<std::size_t> waiting = nodes;
+  std::vector<Request> in_flight;
+  bool failed = false;
+
+  auto report = [&](std::size_t index, bool success, std::chrono::steady_clock::time_point start) {
+      TransitionReport transition_report;
+      transition_report.node_name = nodes_[index].name;
+      transition_report.transition_id = transition_id;
+      transition_report.success = success;
+      transition_report.rollback = rollback;
+      transition_report.duration = std::chrono::steady_clock::now() - start;
+      result.transitions.push_back(transition_report);
+    };
+
+  while (!waiting.empty() || !in_flight.empty()) {
+    bool progress = false;
+    // Start every transition whose blocking nodes are done, unless something failed already
+    for (auto it = waiting.begin(); !failed && it != waiting.end(); ) {
+      const auto & managed_node = nodes_[*it];
+      const auto & blockers = reverse ? managed_node.dependents : managed_node.dependencies;
+      bool ready = std::all_of(
+        blockers.begin(), blockers.end(),
+        [&](std::size_t blocker) {return !involved[blocker] || done[blocker];});
+      if (!ready || !managed_node.client->service_is_ready()) {
+        ++it;
+        continue;
+      }
+      auto request = std::make_shared<ChangeState::Request>();
+      request->transition.id = transition_id;
+      in_flight.push_back(
+        Request{*it, managed_node.client->async_send_request(request),
+          std::chrono::steady_clock::now()});
+      it = waiting.erase(it);
+      progress = true;
+    }
+    if (failed && in_flight.empty()) {
+      break;
+    }
+
+    for (auto it = in_flight.begin(); it != in_flight.end(); ) {
+      if (it->future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        ++it;
+        continue;
+      }
+      bool success = it->future.get()->success;
+      report(it->index, success, it->start);
+      if (success) {
+        done[it->index] = true;
+        succeeded.push_back(it->index);
+      } else {
+        failed = true;
+      }
+      it = in_flight.erase(it);
+      progress = true;
+    }
+
+    if (!rclcpp::ok() || std::chrono::steady_clock::now() > deadline) {
+      result.deadline_exceeded = rclcpp::ok();
+      for (auto & request : in_flight) {
+        nodes_[request.index].client->remove_pending_request(request.future);
+        report(request.index, false, request.start);
+        timed_out.push_back(request.index);
+      }
+      return false;
+    }
+    if (!progress) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  return !failed;
+}
+
+std::uint8_t LifecycleOrchestrator::queryState(
+  std::size_t index,
+  std::chrono::steady_clock::time_point deadline)
+{
+  const auto & client = nodes_[index].state_client;
+  while (rclcpp::ok() && std::chrono::steady_clock::now() < deadline) {
+    if (!client->service_is_ready()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    auto future = client->async_send_request(std::make_shared<GetState::Request>());
+    if (future.wait_for(deadline - std::chrono::steady_clock::now()) !=
+      std::future_status::ready)
+    {
+      client->remove_pending_request(future);
+      break;
+    }
+    auto state = future.get()->current_state.id;
+    // Transition states have ids from 10, the node may be still processing the request
+    if (state < State::TRANSITION_STATE_CONFIGURING) {
+      return state;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return State::PRIMARY_STATE_UNKNOWN;
+}
+
+std::vector<std::size_t> LifecycleOrchestrator::allNodes() const
+{
+  std::vector<std::size_t> indices(nodes_.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = i;
+  }
+  return indices;
+}
+}  // namespace kroshu_ros2_core
@@ -14,15 +14,113 @@
 
 #include "kroshu_ros2_core/ParameterHandler.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace kroshu_ros2_core
 {
-ParameterHandler::ParameterHandler(rclcpp_lifecycle::LifecycleNode * node)
-: node_(node)
+ParameterConstraints ParameterConstraints::integerRange(
+  std::int64_t from, std::int64_t to,
+  std::uint64_t step)
 {
+  ParameterConstraints constraints;
+  rcl_interfaces::msg::IntegerRange range;
+  range.from_value = from;
+  range.to_value = to;
+  range.step = step;
+  constraints.descriptor.integer_range.push_back(range);
+  return constraints;
+}
+
+ParameterConstraints ParameterConstraints::floatingPointRange(double from, double to, double step)
+{
+  ParameterConstraints constraints;
+  rcl_interfaces::msg::FloatingPointRange range;
+  range.from_value = from;
+  range.to_value = to;
+  range.step = step;
+  constraints.descriptor.floating_point_range.push_back(range);
+  return constraints;
+}
+
+bool ParameterConstraints::validate(const rclcpp::Parameter & param, std::string & reason) const
+{
+  // Same rules as rclcpp, where a value equal to the upper bound is valid regardless of the step
+  if (!descriptor.integer_range.empty() &&
+    param.get_type() == rclcpp::ParameterType::PARAMETER_INTEGER)
+  {
+    const auto & range = descriptor.integer_range.front();
+    auto value = param.as_int();
+    if (value < range.from_value || value > range.to_value ||
+      (range.step != 0 && value != range.to_value &&
+      static_cast<std::uint64_t>(value - range.from_value) % range.step != 0))
+    {
+      reason = "Parameter " + param.get_name() + " must be in [" +
+        std::to_string(range.from_value) + ", " + std::to_string(range.to_value) + "]" +
+        (range.step != 0 ? " with a step of " + std::to_string(range.step) : "");
+      return false;
+    }
+  }
+  if (!descriptor.floating_point_range.empty() &&
+    param.get_type() == rclcpp::ParameterType::PARAMETER_DOUBLE)
+  {
+    const auto & range = descriptor.floating_point_range.front();
+    auto value = param.as_double();
+    bool on_step = true;
+    if (range.step != 0.0 && value != range.to_value) {
+      double steps = (value - range.from_value) / range.step;
+      on_step = std::fabs(steps - std::round(steps)) <= 1e-9 * std::max(1.0, std::fabs(steps));
+    }
+    if (!(value >= range.from_value && value <= range.to_value) || !on_step) {
+      reason = "Parameter " + param.get_name() + " must be in [" +
+        std::to_string(range.from_value) + ", " + std::to_string(range.to_value) + "]" +
+        (range.step != 0.0 ? " with a step of " + std::to_string(range.step) : "");
+      return false;
+    }
+  }
+  if (!allowed_values.empty() &&
+    std::find(
+      allowed_values.begin(), allowed_values.end(),
+      param.get_parameter_value()) == allowed_values.end())
+  {
+    reason = "Parameter " + param.get_name() + " must be one of: " +
+      describeAllowedValues(allowed_values);
+    return false;
+  }
+  return true;
+}
+
+std::string ParameterConstraints::describeAllowedValues(
+  const std::vector<rclcpp::ParameterValue> & values)
+{
+  std::string description;
+  for (const auto & value : values) {
+    if (!description.empty()) {
+      description += ", ";
+    }
+    description += rclcpp::to_string(value);
+  }
+  return description;
+}
+
+ParameterHandler::ParameterHandler(
+  rclcpp_lifecycle::LifecycleNode * node,
+  RealTimeLogger * logger)
+: node_(node), logger_(logger)
+{
+}
+
+RealTimeLogger & ParameterHandler::getLogger() const
+{
+  if (logger_ != nullptr) {
+    return *logger_;
+  }
+  static RealTimeLogger default_logger("ParameterHandler");
+  return default_logger;
 }
 
 rcl_interfaces::msg::SetParametersResult ParameterHandler::onParamChange(
@@ -30,24 +128,57 @@ rcl_interfaces::msg::SetParametersResult ParameterHandler::onParamChange(
 {
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = false;
+  // The batch is rejected as a whole before any callback could apply a value
+  for (const rclcpp::Parameter & param : parameters) {
+    if (!validateParameter(param, result.reason)) {
+      KROSHU_RT_LOG_ERROR(getLogger(), "%s", result.reason);
+      return result;
+    }
+  }
+  result.successful = !parameters.empty();
   for (const rclcpp::Parameter & param : parameters) {
-    auto found_param_it = std::find_if(
-      params_.begin(), params_.end(),
-      [&param](auto param_ptr) {
-        return param_ptr->getName() == param.get_name();
-      });
-    // When used properly, we should not reach this
-    // but better to keep additional check to filter improper use
-    if (found_param_it == params_.end()) {
-      printf("Invalid parameter name\n");
-    } else if (canSetParameter(*(*found_param_it))) {
-      result.successful = (*found_param_it)->callCallback(param);
+    if (!params_.at(param.get_name())->callCallback(param)) {
+      result.successful = false;
+      result.reason = "Parameter " + param.get_name() + " was rejected by the node";
     }
   }
   return result;
 }
 
+bool ParameterHandler::validateParameter(
+  const rclcpp::Parameter & param,
+  std::string & reason) const
+{
+  auto found_param_it = params_.find(param.get_name());
+  // When used properly, we should not reach this
+  // but better to keep additional check to filter improper use
+  if (found_param_it == params_.end()) {
+    reason = "Invalid parameter name " + param.get_name();
+    return false;
+  }
+  const auto & found_param = *found_param_it->second;
+  if (!canSetParameter(found_param, reason)) {
+    return false;
+  }
+  if (param.get_type() != found_param.getDefaultValue().get_type()) {
+    reason = "Parameter " + param.get_name() + " must be of type " +
+      rclcpp::to_string(found_param.getDefaultValue().get_type());
+    return false;
+  }
+  return found_param.getConstraints().validate(param, reason);
+}
+
 bool ParameterHandler::canSetParameter(const ParameterBase & param) const
+{
+  std::string reason;
+  if (!canSetParameter(param, reason)) {
+    KROSHU_RT_LOG_ERROR(getLogger(), "%s", reason);
+    return false;
+  }
+  return true;
+}
+
+bool ParameterHandler::canSetParameter(const ParameterBase & param, std::string & reason) const
 {
   if (node_ == nullptr) {
     // Node is not lifecycle node, paramater can always be set
@@ -55,17 +186,13 @@ bool ParameterHandler::canSetParameter(const ParameterBase & param) const
   }
   try {
     if (!param.getRights().isSetAllowed(node_->get_current_state().id())) {
-      RCLCPP_ERROR(
-        node_->get_logger(),
-        "Parameter %s cannot be changed while in state %s",
-        param.getName().c_str(), node_->get_current_state().label().c_str());
+      reason = "Parameter " + param.getName() + " cannot be changed while in state " +
+        node_->get_current_state().label();
       return false;
     }
   } catch (const std::out_of_range &) {
-    RCLCPP_ERROR(
-      node_->get_logger(),
-      "Parameter set access rights for parameter %s couldn't be determined",
-      param.getName().c_str());
+    reason = "Parameter set access rights for parameter " + param.getName() +
+      " couldn't be determined";
     return false;
   }
   return true;
@@ -75,12 +202,58 @@ void ParameterHandler::registerParameter(
   std::shared_ptr<ParameterBase> param_shared_ptr,
   bool block)
 {
-  params_.emplace_back(param_shared_ptr);
-  param_shared_ptr->getParameterInterface()->declare_parameter(
-    param_shared_ptr->getName(), param_shared_ptr->getDefaultValue());
+  const auto & name = param_shared_ptr->getName();
+  // The on set callbacks are called during the declaration, so the parameter must be found
+  //  by then, but it is kept only if the declaration succeeds
+  auto inserted = params_.emplace(name, param_shared_ptr);
+  if (!inserted.second) {
+    throw rclcpp::exceptions::ParameterAlreadyDeclaredException(
+            "parameter '" + name + "' has already been declared");
+  }
+  try {
+    param_shared_ptr->getParameterInterface()->declare_parameter(
+      name, param_shared_ptr->getDefaultValue(), describe(*param_shared_ptr, block));
+  } catch (...) {
+    params_.erase(inserted.first);
+    throw;
+  }
   if (block) {
     param_shared_ptr->blockParameter();
   }
 }
 
+rcl_interfaces::msg::ParameterDescriptor ParameterHandler::describe(
+  const ParameterBase & param,
+  bool block) const
+{
+  auto descriptor = param.getConstraints().descriptor;
+  descriptor.name = param.getName();
+  descriptor.type = param.getDefaultValue().get_type();
+
+  std::string settable;
+  if (block) {
+    settable = "Can be set only at startup";
+  } else if (node_ != nullptr) {
+    const auto & rights = param.getRights();
+    const std::pair<bool, const char *> states[] = {
+      {rights.unconfigured, "unconfigured"}, {rights.inactive, "inactive"},
+      {rights.active, "active"}, {rights.finalized, "finalized"}};
+    for (const auto & state : states) {
+      if (state.first) {
+        settable += settable.empty() ? "Can be set in states: " : ", ";
+        settable += state.second;
+      }
+    }
+    if (settable.empty()) {
+      settable = "Can be set only at startup";
+    }
+  }
+  if (!settable.empty()) {
+    if (!descriptor.additional_constraints.empty()) {
+      descriptor.additional_constraints += "; ";
+    }
+    descriptor.additional_constraints += settable;
+  }
+  return descriptor;
+}
 }  // namespace kroshu_ros2_core
@@ -0,0 +1,164 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "kroshu_ros2_core/PerformanceCounters.hpp"
+
+namespace kroshu_ros2_core
+{
+namespace
+{
+diagnostic_msgs::msg::KeyValue makeKeyValue(const std::string & key, const std::string & value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  return key_value;
+}
+}  // namespace
+
+std::shared_ptr<PerformanceCounter> PerformanceCounters::addCounter(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto & entry = counters_[name];
+  if (!entry.counter) {
+    entry.counter = std::make_shared<PerformanceCounter>(enabled_);
+  }
+  return entry.counter;
+}
+
+std::shared_ptr<PerformanceTimer> PerformanceCounters::addTimer(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto & entry = timers_[name];
+  if (!entry.timer) {
+    entry.timer = std::make_shared<PerformanceTimer>(enabled_);
+  }
+  return entry.timer;
+}
+
+void PerformanceCounters::setEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (enabled && !enabled_->load(std::memory_order_relaxed)) {
+    // The rates of the first report must not include the disabled period
+    restartReport();
+  }
+  enabled_->store(enabled, std::memory_order_relaxed);
+}
+
+diagnostic_msgs::msg::DiagnosticStatus PerformanceCounters::report(const std::string & node_name)
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = node_name + ": performance";
+  status.hardware_id = node_name;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto now = std::chrono::steady_clock::now();
+  double elapsed_s = std::chrono::duration<double>(now - last_report_).count();
+  last_report_ = now;
+  status.message = "Values of the last " + std::to_string(elapsed_s) + " s";
+
+  for (auto & entry : counters_) {
+    auto value = entry.second.counter->value();
+    auto delta = value - entry.second.reported_value;
+    entry.second.reported_value = value;
+    status.values.push_back(makeKeyValue(entry.first, std::to_string(value)));
+    status.values.push_back(
+      makeKeyValue(
+        entry.first + " rate [1/s]",
+        std::to_string(elapsed_s > 0.0 ? delta / elapsed_s : 0.0)));
+  }
+  for (auto & entry : timers_) {
+    auto & timer = *entry.second.timer;
+    auto count = timer.count();
+    auto sum_ns = timer.sumNanoseconds();
+    auto delta_count = count - entry.second.reported_count;
+    auto delta_sum_ns = sum_ns - entry.second.reported_sum_ns;
+    entry.second.reported_count = count;
+    entry.second.reported_sum_ns = sum_ns;
+    status.values.push_back(makeKeyValue(entry.first + " samples", std::to_string(delta_count)));
+    status.values.push_back(
+      makeKeyValue(
+        entry.first + " rate [1/s]",
+        std::to_string(elapsed_s > 0.0 ? delta_count / elapsed_s : 0.0)));
+    status.values.push_back(
+      makeKeyValue(
+        entry.first + " mean [us]",
+        std::to_string(delta_count > 0 ? delta_sum_ns / 1000.0 / delta_count : 0.0)));
+    status.values.push_back(
+      makeKeyValue(entry.first + " max [us]", std::to_string(timer.takeMaxNanoseconds() / 1000)));
+  }
+  return status;
+}
+
+void PerformanceCounters::restartReport()
+{
+  last_report_ = std::chrono::steady_clock::now();
+  for (auto & entry : counters_) {
+    entry.second.reported_value = entry.second.counter->value();
+  }
+  for (auto & entry : timers_) {
+    entry.second.reported_count = entry.second.timer->count();
+    entry.second.reported_sum_ns = entry.second.timer->sumNanoseconds();
+    entry.second.timer->takeMaxNanoseconds();
+  }
+}
+
+PerformanceReporter::PerformanceReporter(
+  PerformanceCounters & counters,
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base,
+  rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr node_topics,
+  rclcpp::node_interfaces::NodeTimersInterface::SharedPtr node_timers,
+  rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock)
+: counters_(counters), node_base_(node_base), node_topics_(node_topics),
+  node_timers_(node_timers), node_clock_(node_clock)
+{
+}
+
+bool PerformanceReporter::setPeriod(std::int64_t period_ms)
+{
+  if (period_ms < 0) {
+    return false;
+  }
+  if (timer_) {
+    timer_->cancel();
+    timer_.reset();
+  }
+  counters_.setEnabled(period_ms > 0);
+  if (period_ms == 0) {
+    return true;
+  }
+
+  if (!publisher_) {
+    publisher_ = rclcpp::create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+      node_topics_, "/diagnostics", rclcpp::SystemDefaultsQoS());
+  }
+  timer_ = rclcpp::create_wall_timer(
+    std::chrono::milliseconds(period_ms), [this]() {publish();}, nullptr,
+    node_base_.get(), node_timers_.get());
+  return true;
+}
+
+void PerformanceReporter::publish()
+{
+  diagnostic_msgs::msg::DiagnosticArray msg;
+  msg.header.stamp = node_clock_->get_clock()->now();
+  msg.status.push_back(counters_.report(node_base_->get_fully_qualified_name()));
+  publisher_->publish(msg);
+}
+}  // namespace kroshu_ros2_core
@@ -12,24 +12,92 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cinttypes>
 #include <string>
 #include <vector>
 #include <memory>
 
 #include "kroshu_ros2_core/ROS2BaseLCNode.hpp"
+#include "kroshu_ros2_core/Components.hpp"
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 
 namespace kroshu_ros2_core
 {
 
 ROS2BaseLCNode::ROS2BaseLCNode(const std::string & node_name, const rclcpp::NodeOptions & options)
-: rclcpp_lifecycle::LifecycleNode(node_name, options)
+: rclcpp_lifecycle::LifecycleNode(node_name, ComponentOptionsScope::resolve(options)),
+  rt_logger_(get_logger().get_name())
 {
-  param_handler_ = ParameterHandler(this);
+  param_handler_ = ParameterHandler(this, &rt_logger_);
+  parameter_changes_ = performance_counters_.addCounter("parameter_changes");
+  parameter_callback_timer_ = performance_counters_.addTimer("parameter_callback");
+  performance_reporter_ = std::make_unique<PerformanceReporter>(
+    performance_counters_, this->get_node_base_interface(), this->get_node_topics_interface(),
+    this->get_node_timers_interface(), this->get_node_clock_interface());
   param_callback_ = this->add_on_set_parameters_callback(
     [this](const std::vector<rclcpp::Parameter> & parameters) {
+      PerformanceTimer::Scope scope(*parameter_callback_timer_);
+      parameter_changes_->increment(parameters.size());
       return param_handler_.onParamChange(parameters);
     });
+  registerParameter<std::int64_t>(
+    "performance_counters_period_ms", 0, {true, true, true, false},
+    ParameterConstraints::integerRange(0, 3600000).withDescription(
+      "Period of the performance counter reports on /diagnostics, 0 disables the counters"),
+    [this](const std::int64_t & period_ms) {
+      return performance_reporter_->setPeriod(period_ms);
+    });
+
+  // Not a lifecycle publisher, so the metrics are published in every state
+  transition_metrics_pub_ = rclcpp::create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+    this->get_node_topics_interface(), "~/transition_metrics",
+    rclcpp::QoS(rclcpp::KeepLast(1)).transient_local());
+
+  // Replaces the default registrations, so every transition is measured
+  //  including the work of the subclass, without changes in the subclasses
+  register_on_configure(
+    [this](const rclcpp_lifecycle::State & state) {
+      return measureTransition("configure", [this, &state]() {return this->on_configure(state);});
+    });
+  register_on_cleanup(
+    [this](const rclcpp_lifecycle::State & state) {
+      setRealTimePublishersActive(false);
+      return measureTransition("cleanup", [this, &state]() {return this->on_cleanup(state);});
+    });
+  register_on_shutdown(
+    [this](const rclcpp_lifecycle::State & state) {
+      setRealTimePublishersActive(false);
+      return measureTransition("shutdown", [this, &state]() {return this->on_shutdown(state);});
+    });
+  register_on_activate(
+    [this](const rclcpp_lifecycle::State & state) {
+      auto result = measureTransition(
+        "activate", [this, &state]() {return this->on_activate(state);});
+      if (result == SUCCESS) {
+        setRealTimePublishersActive(true);
+      }
+      return result;
+    });
+  register_on_deactivate(
+    [this](const rclcpp_lifecycle::State & state) {
+      setRealTimePublishersActive(false);
+      return measureTransition(
+        "deactivate", [this, &state]() {return this->on_deactivate(state);});
+    });
+  // The recorders are frozen before the error is handled
+  register_on_error(
+    [this](const rclcpp_lifecycle::State & state) {
+      setRealTimePublishersActive(false);
+      for (auto & recorder : cycle_recorders_) {
+        recorder->freeze();
+      }
+      return measureTransition("error", [this, &state]() {return this->on_error(state);});
+    });
+}
+
+ROS2BaseLCNode::ROS2BaseLCNode(const rclcpp::NodeOptions & options)
+: ROS2BaseLCNode("base_lifecycle_node", options)
+{
 }
 
 rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
@@ -91,6 +159,76 @@ const ParameterHandler & ROS2BaseLCNode::getParameterHandler() const
   return param_handler_;
 }
 
+RealTimeLogger & ROS2BaseLCNode::getRealTimeLogger()
+{
+  return rt_logger_;
+}
+
+PerformanceCounters & ROS2BaseLCNode::getPerformanceCounters()
+{
+  return performance_counters_;
+}
+
+void ROS2BaseLCNode::registerCycleRecorder(std::shared_ptr<CycleRecorder> recorder)
+{
+  cycle_recorders_.push_back(recorder);
+}
+
+void ROS2BaseLCNode::setRealTimePublishersActive(bool active)
+{
+  std::lock_guard<std::mutex> lock(rt_publishers_mutex_);
+  for (auto it = rt_publishers_.begin(); it != rt_publishers_.end(); ) {
+    if (auto publisher = it->lock()) {
+      if (active) {
+        publisher->activate();
+      } else {
+        publisher->deactivate();
+      }
+      ++it;
+    } else {
+      // The publisher was destroyed by its owner
+      it = rt_publishers_.erase(it);
+    }
+  }
+}
+
+std::map<std::string, TransitionMetrics> ROS2BaseLCNode::getTransitionMetrics() const
+{
+  std::lock_guard<std::mutex> lock(transition_metrics_mutex_);
+  return transition_metrics_;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+ROS2BaseLCNode::measureTransition(
+  const std::string & transition,
+  const std::function<rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn()>
+  & callback)
+{
+  TransitionProbe probe;
+  auto result = callback();
+  auto metrics = probe.stop(
+    transition,
+    result == SUCCESS ? "success" : (result == FAILURE ? "failure" : "error"));
+
+  RCLCPP_INFO(
+    get_logger(), "Transition %s: %s in %.3f ms, %" PRId64 " allocations, RSS %+" PRId64 " kB",
+    transition.c_str(), metrics.result.c_str(),
+    std::chrono::duration<double, std::milli>(metrics.duration).count(), metrics.allocations,
+    metrics.rss_delta_bytes / 1024);
+
+  diagnostic_msgs::msg::DiagnosticArray msg;
+  msg.header.stamp = now();
+  {
+    std::lock_guard<std::mutex> lock(transition_metrics_mutex_);
+    transition_metrics_[transition] = metrics;
+    for (const auto & entry : transition_metrics_) {
+      msg.status.push_back(toDiagnosticStatus(entry.second, get_fully_qualified_name()));
+    }
+  }
+  transition_metrics_pub_->publish(msg);
+  return result;
+}
+
 rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr ROS2BaseLCNode::ParamCallback()
 const
 {
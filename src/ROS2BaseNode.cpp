@@ -17,18 +17,40 @@
 #include <memory>
 
 #include "kroshu_ros2_core/ROS2BaseNode.hpp"
+#include "kroshu_ros2_core/Components.hpp"
 
 
 namespace kroshu_ros2_core
 {
 
 ROS2BaseNode::ROS2BaseNode(const std::string & node_name, const rclcpp::NodeOptions & options)
-: rclcpp::Node(node_name, options)
+: rclcpp::Node(node_name, ComponentOptionsScope::resolve(options)),
+  rt_logger_(get_logger().get_name())
 {
+  param_handler_ = ParameterHandler(nullptr, &rt_logger_);
+  parameter_changes_ = performance_counters_.addCounter("parameter_changes");
+  parameter_callback_timer_ = performance_counters_.addTimer("parameter_callback");
+  performance_reporter_ = std::make_unique<PerformanceReporter>(
+    performance_counters_, this->get_node_base_interface(), this->get_node_topics_interface(),
+    this->get_node_timers_interface(), this->get_node_clock_interface());
   param_callback_ = this->add_on_set_parameters_callback(
     [this](const std::vector<rclcpp::Parameter> & parameters) {
+      PerformanceTimer::Scope scope(*parameter_callback_timer_);
+      parameter_changes_->increment(parameters.size());
       return param_handler_.onParamChange(parameters);
     });
+  registerParameter<std::int64_t>(
+    "performance_counters_period_ms", 0,
+    ParameterConstraints::integerRange(0, 3600000).withDescription(
+      "Period of the performance counter reports on /diagnostics, 0 disables the counters"),
+    [this](const std::int64_t & period_ms) {
+      return performance_reporter_->setPeriod(period_ms);
+    });
+}
+
+ROS2BaseNode::ROS2BaseNode(const rclcpp::NodeOptions & options)
+: ROS2BaseNode("base_node", options)
+{
 }
 
 const ParameterHandler & ROS2BaseNode::getParameterHandler() const
@@ -36,6 +58,16 @@ const ParameterHandler & ROS2BaseNode::getParameterHandler() const
   return param_handler_;
 }
 
+RealTimeLogger & ROS2BaseNode::getRealTimeLogger()
+{
+  return rt_logger_;
+}
+
+PerformanceCounters & ROS2BaseNode::getPerformanceCounters()
+{
+  return performance_counters_;
+}
+
 rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr ROS2BaseNode::ParamCallback()
 const
 {
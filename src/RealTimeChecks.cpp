@@ -0,0 +1,263 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interposes the allocator and common blocking calls to detect their use in sections
+//  marked with KROSHU_RT_SECTION(). The library is meant to be preloaded in test runs:
+//  LD_PRELOAD=libkroshu_rt_checks.so KROSHU_RT_CHECKS=abort ros2 run ...
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t count, std::size_t size);
+void * __libc_realloc(void * ptr, std::size_t size);
+void * __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void * ptr);
+}
+
+namespace
+{
+enum class Mode
+{
+  COUNT,
+  BACKTRACE,
+  ABORT,
+};
+
+// Initial-exec TLS does not allocate on first access, so it is safe to use inside malloc
+__thread int section_depth __attribute__((tls_model("initial-exec"))) = 0;
+__thread bool reporting __attribute__((tls_model("initial-exec"))) = false;
+__thread std::uint64_t thread_allocations __attribute__((tls_model("initial-exec"))) = 0;
+
+Mode mode = Mode::COUNT;
+std::atomic<std::uint64_t> allocation_violations {0};
+std::atomic<std::uint64_t> blocking_violations {0};
+
+using MutexLockFunction = int (*)(pthread_mutex_t *);
+using NanosleepFunction = int (*)(const struct timespec *, struct timespec *);
+using ClockNanosleepFunction =
+  int (*)(clockid_t, int, const struct timespec *, struct timespec *);
+using UsleepFunction = int (*)(useconds_t);
+using SleepFunction = unsigned int (*)(unsigned int);
+
+template<typename FunctionT>
+FunctionT resolve(FunctionT & function, const char * name)
+{
+  // Benign race: every thread resolves the same address
+  if (function == nullptr) {
+    function = reinterpret_cast<FunctionT>(dlsym(RTLD_NEXT, name));
+  }
+  return function;
+}
+
+MutexLockFunction real_mutex_lock = nullptr;
+MutexLockFunction real_mutex_trylock = nullptr;
+NanosleepFunction real_nanosleep = nullptr;
+ClockNanosleepFunction real_clock_nanosleep = nullptr;
+UsleepFunction real_usleep = nullptr;
+SleepFunction real_sleep = nullptr;
+
+bool isChecking()
+{
+  return section_depth > 0 && !reporting;
+}
+
+void writeString(const char * message)
+{
+  auto result = write(STDERR_FILENO, message, strlen(message));
+  static_cast<void>(result);
+}
+
+void reportViolation(const char * call, std::atomic<std::uint64_t> & counter)
+{
+  reporting = true;
+  counter.fetch_add(1, std::memory_order_relaxed);
+  if (mode != Mode::COUNT) {
+    writeString("kroshu_rt_checks: ");
+    writeString(call);
+    writeString(" called in a real-time section\n");
+    void * frames[64];
+    int frame_count = backtrace(frames, 64);
+    backtrace_symbols_fd(frames, frame_count, STDERR_FILENO);
+  }
+  if (mode == Mode::ABORT) {
+    abort();
+  }
+  reporting = false;
+}
+
+void checkAllocation(const char * call)
+{
+  thread_allocations++;
+  if (isChecking()) {
+    reportViolation(call, allocation_violations);
+  }
+}
+
+void checkBlocking(const char * call)
+{
+  if (isChecking()) {
+    reportViolation(call, blocking_violations);
+  }
+}
+
+__attribute__((constructor)) void initialize()
+{
+  const char * mode_name = getenv("KROSHU_RT_CHECKS");
+  if (mode_name != nullptr && strcmp(mode_name, "backtrace") == 0) {
+    mode = Mode::BACKTRACE;
+  } else if (mode_name != nullptr && strcmp(mode_name, "abort") == 0) {
+    mode = Mode::ABORT;
+  }
+  // The first backtrace loads libgcc, which allocates, so it is done outside of any section
+  void * frame;
+  backtrace(&frame, 1);
+  resolve(real_mutex_lock, "pthread_mutex_lock");
+  resolve(real_mutex_trylock, "pthread_mutex_trylock");
+  resolve(real_nanosleep, "nanosleep");
+  resolve(real_clock_nanosleep, "clock_nanosleep");
+  resolve(real_usleep, "usleep");
+  resolve(real_sleep, "sleep");
+}
+
+__attribute__((destructor)) void summarize()
+{
+  fprintf(
+    stderr, "kroshu_rt_checks: %lu allocations and %lu blocking calls in real-time sections\n",
+    static_cast<unsigned long>(allocation_violations.load()),  // NOLINT(runtime/int)
+    static_cast<unsigned long>(blocking_violations.load()));  // NOLINT(runtime/int)
+}
+}  // namespace
+
+extern "C" {
+void kroshu_rt_section_enter()
+{
+  section_depth++;
+}
+
+void kroshu_rt_section_exit()
+{
+  section_depth--;
+}
+
+std::uint64_t kroshu_rt_violation_count()
+{
+  return allocation_violations.load(std::memory_order_relaxed) +
+         blocking_violations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t kroshu_thread_allocation_count()
+{
+  return thread_allocations;
+}
+
+void * malloc(std::size_t size)
+{
+  checkAllocation("malloc");
+  return __libc_malloc(size);
+}
+
+void * calloc(std::size_t count, std::size_t size)
+{
+  checkAllocation("calloc");
+  return __libc_calloc(count, size);
+}
+
+void * realloc(void * ptr, std::size_t size)
+{
+  checkAllocation("realloc");
+  return __libc_realloc(ptr, size);
+}
+
+void * memalign(std::size_t alignment, std::size_t size)
+{
+  checkAllocation("memalign");
+  return __libc_memalign(alignment, size);
+}
+
+void * aligned_alloc(std::size_t alignment, std::size_t size)
+{
+  checkAllocation("aligned_alloc");
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void ** ptr, std::size_t alignment, std::size_t size)
+{
+  checkAllocation("posix_memalign");
+  if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+    return EINVAL;
+  }
+  void * result = __libc_memalign(alignment, size);
+  if (result == nullptr) {
+    return ENOMEM;
+  }
+  *ptr = result;
+  return 0;
+}
+
+void free(void * ptr)
+{
+  if (ptr != nullptr && isChecking()) {
+    reportViolation("free", allocation_violations);
+  }
+  __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t * mutex)
+{
+  // Taking a free mutex does not block, only contended locks are reported
+  if (isChecking() && resolve(real_mutex_trylock, "pthread_mutex_trylock")(mutex) == 0) {
+    return 0;
+  }
+  checkBlocking("pthread_mutex_lock (contended)");
+  return resolve(real_mutex_lock, "pthread_mutex_lock")(mutex);
+}
+
+int nanosleep(const struct timespec * request, struct timespec * remaining)
+{
+  checkBlocking("nanosleep");
+  return resolve(real_nanosleep, "nanosleep")(request, remaining);
+}
+
+int clock_nanosleep(
+  clockid_t clock_id, int flags, const struct timespec * request,
+  struct timespec * remaining)
+{
+  checkBlocking("clock_nanosleep");
+  return resolve(real_clock_nanosleep, "clock_nanosleep")(clock_id, flags, request, remaining);
+}
+
+int usleep(useconds_t usec)
+{
+  checkBlocking("usleep");
+  return resolve(real_usleep, "usleep")(usec);
+}
+
+unsigned int sleep(unsigned int seconds)
+{
+  checkBlocking("sleep");
+  return resolve(real_sleep, "sleep")(seconds);
+}
+}  // extern "C"
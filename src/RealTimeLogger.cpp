@@ -0,0 +1,322 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/logging.hpp"
+
+#include "kroshu_ros2_core/RealTimeLogger.hpp"
+
+namespace kroshu_ros2_core
+{
+constexpr std::size_t LogRecord::MAX_ARGUMENTS;
+constexpr std::size_t LogRecord::STRING_CAPACITY;
+
+namespace
+{
+/**
+ * @brief Background thread draining every registered real-time logger
+ */
+class LogDrainer
+{
+public:
+  static LogDrainer & instance()
+  {
+    static LogDrainer drainer;
+    return drainer;
+  }
+
+  void add(RealTimeLogger * logger)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loggers_.push_back(logger);
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this]() {run();});
+    }
+  }
+
+  void remove(RealTimeLogger * logger)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loggers_.erase(std::remove(loggers_.begin(), loggers_.end(), logger), loggers_.end());
+  }
+
+  ~LogDrainer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+private:
+  LogDrainer() = default;
+
+  void run()
+  {
+    // The real-time side does not notify, the queues are polled periodically
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+      for (auto logger : loggers_) {
+        logger->drain();
+      }
+      stop_cv_.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable stop_cv_;
+  std::vector<RealTimeLogger *> loggers_;
+  std::thread thread_;
+  bool stop_ = false;
+};
+
+std::size_t roundUpToPowerOfTwo(std::size_t value)
+{
+  std::size_t result = 2;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+/**
+ * @brief Formats a single conversion, the length modifiers of the format are replaced
+ *  according to the type the argument was stored with
+ */
+void appendArgument(
+  std::string & out, const std::string & specification, char conversion,
+  const LogRecord & record, const LogArgument & argument)
+{
+  char buffer[512];
+  int length = 0;
+  std::string spec = specification;
+  switch (conversion) {
+    case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+      {
+        long long value = argument.type == LogArgument::Type::FLOATING ?  // NOLINT(runtime/int)
+          static_cast<long long>(argument.floating_value) :  // NOLINT(runtime/int)
+          argument.signed_value;
+        if (conversion == 'c') {
+          length = snprintf(buffer, sizeof(buffer), (spec + 'c').c_str(), static_cast<int>(value));
+        } else {
+          length = snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(), value);
+        }
+        break;
+      }
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+      {
+        double value = argument.floating_value;
+        if (argument.type == LogArgument::Type::SIGNED) {
+          value = static_cast<double>(argument.signed_value);
+        } else if (argument.type == LogArgument::Type::UNSIGNED) {
+          value = static_cast<double>(argument.unsigned_value);
+        }
+        length = snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), value);
+        break;
+      }
+    case 's':
+      length = snprintf(
+        buffer, sizeof(buffer), (spec + 's').c_str(),
+        argument.type == LogArgument::Type::STRING ?
+        record.strings + argument.string_offset : "<not a string>");
+      break;
+    case 'p':
+      length = snprintf(buffer, sizeof(buffer), (spec + 'p').c_str(), argument.pointer_value);
+      break;
+    default:
+      out += specification + conversion;
+      return;
+  }
+  if (length > 0) {
+    out.append(buffer, std::min(static_cast<std::size_t>(length), sizeof(buffer) - 1));
+  }
+}
+}  // namespace
+
+RealTimeLogger::RealTimeLogger(const std::string & logger_name, std::size_t capacity)
+: logger_(rclcpp::get_logger(logger_name)),
+  cells_(new Cell[roundUpToPowerOfTwo(capacity)]),
+  mask_(roundUpToPowerOfTwo(capacity) - 1)
+{
+  for (std::size_t i = 0; i <= mask_; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  LogDrainer::instance().add(this);
+}
+
+RealTimeLogger::~RealTimeLogger()
+{
+  LogDrainer::instance().remove(this);
+  drain();
+}
+
+bool RealTimeLogger::checkRate(LogCallSite & site, std::uint64_t & suppressed) noexcept
+{
+  if (site.min_interval_ns <= 0) {
+    return true;
+  }
+  std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  std::int64_t last = site.last_log_ns.load(std::memory_order_relaxed);
+  if ((last != std::numeric_limits<std::int64_t>::min() && now - last < site.min_interval_ns) ||
+    !site.last_log_ns.compare_exchange_strong(last, now, std::memory_order_relaxed))
+  {
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+  return true;
+}
+
+RealTimeLogger::Cell * RealTimeLogger::beginPush(std::size_t & position) noexcept
+{
+  // Bounded multi-producer queue, see D. Vyukov's bounded MPMC queue
+  position = enqueue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell * cell = &cells_[position & mask_];
+    std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+    if (difference == 0) {
+      if (enqueue_position_.compare_exchange_weak(
+          position, position + 1,
+          std::memory_order_relaxed))
+      {
+        return cell;
+      }
+    } else if (difference < 0) {
+      return nullptr;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void RealTimeLogger::endPush(Cell * cell, std::size_t position) noexcept
+{
+  cell->sequence.store(position + 1, std::memory_order_release);
+}
+
+void RealTimeLogger::fillArgument(
+  LogRecord & record, LogArgument & argument,
+  const char * value) noexcept
+{
+  argument.type = LogArgument::Type::STRING;
+  argument.string_offset = record.string_length;
+  if (value == nullptr) {
+    value = "(null)";
+  }
+  // Strings are truncated if the record runs out of space
+  std::size_t free_space = LogRecord::STRING_CAPACITY - record.string_length;
+  std::size_t length = strnlen(value, free_space - 1);
+  std::memcpy(record.strings + record.string_length, value, length);
+  record.strings[record.string_length + length] = '\0';
+  record.string_length += std::min(length + 1, free_space - 1);
+}
+
+std::size_t RealTimeLogger::drain()
+{
+  // Only the drainer thread or the destructor consumes, so a single consumer is assumed
+  std::size_t count = 0;
+  while (true) {
+    std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Cell & cell = cells_[position & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+      break;
+    }
+    LogRecord record = cell.record;
+    dequeue_position_.store(position + 1, std::memory_order_relaxed);
+    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+
+    std::string message = format(record);
+    if (record.suppressed > 0) {
+      message += " (" + std::to_string(record.suppressed) + " similar messages suppressed)";
+    }
+    switch (record.severity) {
+      case LogSeverity::DEBUG:
+        RCLCPP_DEBUG(logger_, "%s", message.c_str());
+        break;
+      case LogSeverity::INFO:
+        RCLCPP_INFO(logger_, "%s", message.c_str());
+        break;
+      case LogSeverity::WARN:
+        RCLCPP_WARN(logger_, "%s", message.c_str());
+        break;
+      case LogSeverity::ERROR:
+        RCLCPP_ERROR(logger_, "%s", message.c_str());
+        break;
+      default:
+        RCLCPP_FATAL(logger_, "%s", message.c_str());
+        break;
+    }
+    count++;
+  }
+
+  auto dropped = getDroppedCount();
+  if (dropped != reported_dropped_) {
+    RCLCPP_WARN(
+      logger_, "%" PRIu64 " real-time log records were dropped because the queue was full",
+      dropped - reported_dropped_);
+    reported_dropped_ = dropped;
+  }
+  return count;
+}
+
+std::string RealTimeLogger::format(const LogRecord & record)
+{
+  std::string result;
+  std::size_t next_argument = 0;
+  for (const char * it = record.format; it != nullptr && *it != '\0'; ++it) {
+    if (*it != '%') {
+      result += *it;
+      continue;
+    }
+    if (*(it + 1) == '%') {
+      result += '%';
+      ++it;
+      continue;
+    }
+    // Collect flags, width and precision, skip the length modifiers
+    std::string specification = "%";
+    ++it;
+    while (*it != '\0' && std::strchr("-+ #0123456789.", *it) != nullptr) {
+      specification += *it++;
+    }
+    while (*it != '\0' && std::strchr("hlLqjzt", *it) != nullptr) {
+      ++it;
+    }
+    if (*it == '\0') {
+      result += specification;
+      break;
+    }
+    if (next_argument >= record.argument_count) {
+      result += specification + *it;
+      continue;
+    }
+    appendArgument(result, specification, *it, record, record.arguments[next_argument++]);
+  }
+  return result;
+}
+}  // namespace kroshu_ros2_core
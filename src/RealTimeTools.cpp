@@ -0,0 +1,104 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "kroshu_ros2_core/RealTimeTools.hpp"
+
+namespace kroshu_ros2_core
+{
+bool setThreadFifoPriority(int priority)
+{
+  struct sched_param param;
+  param.sched_priority = priority;
+  return sched_setscheduler(0, SCHED_FIFO, &param) == 0;
+}
+
+bool setThreadAffinity(const std::vector<std::int64_t> & cpus)
+{
+  if (cpus.empty()) {
+    return true;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      errno = EINVAL;
+      return false;
+    }
+    CPU_SET(static_cast<int>(cpu), &cpu_set);
+  }
+  int result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (result != 0) {
+    errno = result;
+    return false;
+  }
+  return true;
+}
+
+bool lockMemory()
+{
+  return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+void prefaultStack(std::size_t size)
+{
+  auto stack = static_cast<volatile char *>(alloca(size));
+  auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  for (std::size_t i = 0; i < size; i += page_size) {
+    stack[i] = 0;
+  }
+}
+
+bool prefaultHeap(std::size_t size)
+{
+  // Freed memory must stay in the process instead of being returned to the OS
+  if (mallopt(M_TRIM_THRESHOLD, -1) == 0 || mallopt(M_MMAP_MAX, 0) == 0) {
+    errno = EINVAL;
+    return false;
+  }
+  auto heap = static_cast<volatile char *>(malloc(size));
+  if (heap == nullptr) {
+    return false;
+  }
+  auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  for (std::size_t i = 0; i < size; i += page_size) {
+    heap[i] = 0;
+  }
+  free(const_cast<char *>(heap));
+  return true;
+}
+
+std::string cpuListToString(const std::vector<std::int64_t> & cpus)
+{
+  std::string result = "[";
+  for (std::size_t i = 0; i < cpus.size(); ++i) {
+    if (i != 0) {
+      result += ", ";
+    }
+    result += std::to_string(cpus[i]);
+  }
+  return result + "]";
+}
+}  // namespace kroshu_ros2_core
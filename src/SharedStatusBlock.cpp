@@ -0,0 +1,188 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "kroshu_ros2_core/SharedStatusBlock.hpp"
+
+namespace kroshu_ros2_core
+{
+static_assert(
+  ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+  "The shared status block needs lock-free atomics");
+
+namespace
+{
+constexpr int kReadAttempts = 4;
+
+std::int64_t steadyNowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+SharedStatusWriter::SharedStatusWriter(const std::string & name)
+: name_(name)
+{
+  int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Could not create " + name_ + ": " + strerror(errno));
+  }
+  if (ftruncate(fd, sizeof(SharedStatusLayout)) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not resize " + name_ + ": " + strerror(errno));
+  }
+  void * memory = mmap(
+    nullptr, sizeof(SharedStatusLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    throw std::runtime_error("Could not map " + name_ + ": " + strerror(errno));
+  }
+
+  // A restarted writer continues the block of its predecessor, so attached readers
+  //  see the heartbeat resume instead of a reinitialized block
+  layout_ = static_cast<SharedStatusLayout *>(memory);
+  if (layout_->magic.load(std::memory_order_acquire) == SharedStatusLayout::MAGIC &&
+    layout_->version.load(std::memory_order_relaxed) == SharedStatusLayout::VERSION)
+  {
+    heartbeat_ = layout_->heartbeat.load(std::memory_order_relaxed);
+    // Completes a write interrupted by the crash of the previous writer
+    auto sequence = layout_->sequence.load(std::memory_order_relaxed);
+    if (sequence & 1) {
+      layout_->sequence.store(sequence + 1, std::memory_order_release);
+    }
+    return;
+  }
+  layout_ = new (memory) SharedStatusLayout;
+  layout_->sequence.store(0, std::memory_order_relaxed);
+  layout_->is_configured.store(0, std::memory_order_relaxed);
+  layout_->control_mode.store(0, std::memory_order_relaxed);
+  layout_->heartbeat.store(0, std::memory_order_relaxed);
+  layout_->heartbeat_time_ns.store(0, std::memory_order_relaxed);
+  layout_->version.store(SharedStatusLayout::VERSION, std::memory_order_relaxed);
+  layout_->magic.store(SharedStatusLayout::MAGIC, std::memory_order_release);
+}
+
+SharedStatusWriter::~SharedStatusWriter()
+{
+  // The object is kept, readers see the heartbeat stop
+  munmap(layout_, sizeof(SharedStatusLayout));
+}
+
+void SharedStatusWriter::write(bool is_configured, ControlMode control_mode)
+{
+  auto sequence = layout_->sequence.load(std::memory_order_relaxed);
+  layout_->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  layout_->is_configured.store(is_configured ? 1 : 0, std::memory_order_relaxed);
+  layout_->control_mode.store(
+    static_cast<std::uint32_t>(control_mode),
+    std::memory_order_relaxed);
+  layout_->heartbeat.store(++heartbeat_, std::memory_order_relaxed);
+  layout_->heartbeat_time_ns.store(steadyNowNs(), std::memory_order_relaxed);
+  layout_->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SharedStatusReader::SharedStatusReader(
+  const std::string & name,
+  std::chrono::nanoseconds watchdog_timeout)
+: name_(name), watchdog_timeout_(watchdog_timeout)
+{
+}
+
+SharedStatusReader::~SharedStatusReader()
+{
+  auto layout = layout_.load();
+  if (layout != nullptr) {
+    munmap(const_cast<SharedStatusLayout *>(layout), sizeof(SharedStatusLayout));
+  }
+}
+
+bool SharedStatusReader::attach()
+{
+  if (layout_.load(std::memory_order_acquire) != nullptr) {
+    return true;
+  }
+  int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+    file_stat.st_size < static_cast<off_t>(sizeof(SharedStatusLayout)))
+  {
+    close(fd);
+    return false;
+  }
+  void * memory = mmap(nullptr, sizeof(SharedStatusLayout), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+  auto layout = static_cast<const SharedStatusLayout *>(memory);
+  if (layout->magic.load(std::memory_order_acquire) != SharedStatusLayout::MAGIC ||
+    layout->version.load(std::memory_order_relaxed) != SharedStatusLayout::VERSION)
+  {
+    munmap(memory, sizeof(SharedStatusLayout));
+    return false;
+  }
+  layout_.store(layout, std::memory_order_release);
+  return true;
+}
+
+RobotStatus SharedStatusReader::read()
+{
+  auto layout = layout_.load(std::memory_order_acquire);
+  if (layout == nullptr) {
+    alive_ = false;
+    RobotStatus status = last_status_;
+    status.is_configured = false;
+    return status;
+  }
+
+  for (int i = 0; i < kReadAttempts; ++i) {
+    auto sequence = layout->sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      continue;
+    }
+    RobotStatus status;
+    status.is_configured = layout->is_configured.load(std::memory_order_relaxed) != 0;
+    status.control_mode =
+      static_cast<ControlMode>(layout->control_mode.load(std::memory_order_relaxed));
+    status.heartbeat = layout->heartbeat.load(std::memory_order_relaxed);
+    status.heartbeat_time_ns = layout->heartbeat_time_ns.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (layout->sequence.load(std::memory_order_relaxed) == sequence) {
+      last_status_ = status;
+      break;
+    }
+  }
+
+  alive_ = last_status_.heartbeat != 0 &&
+    steadyNowNs() - last_status_.heartbeat_time_ns <= watchdog_timeout_.count();
+  RobotStatus status = last_status_;
+  status.is_configured = status.is_configured && alive_;
+  return status;
+}
+}  // namespace kroshu_ros2_core
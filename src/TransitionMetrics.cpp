@@ -0,0 +1,122 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "kroshu_ros2_core/TransitionMetrics.hpp"
+
+// Defined by the kroshu_rt_checks library, null if it is not loaded
+extern "C" {
+std::uint64_t kroshu_thread_allocation_count() __attribute__((weak));
+}
+
+namespace kroshu_ros2_core
+{
+namespace
+{
+std::int64_t readResidentSetSize()
+{
+  // /proc/self/statm: size resident shared text lib data dt, in pages
+  int fd = open("/proc/self/statm", O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  char buffer[128];
+  auto length = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (length <= 0) {
+    return 0;
+  }
+  buffer[length] = '\0';
+  char * resident = nullptr;
+  std::strtoll(buffer, &resident, 10);
+  return std::strtoll(resident, nullptr, 10) * sysconf(_SC_PAGESIZE);
+}
+
+std::int64_t readHeapSize()
+{
+  return static_cast<std::int64_t>(mallinfo2().uordblks);
+}
+
+std::int64_t readAllocationCount()
+{
+  if (kroshu_thread_allocation_count == nullptr) {
+    return -1;
+  }
+  return static_cast<std::int64_t>(kroshu_thread_allocation_count());
+}
+
+diagnostic_msgs::msg::KeyValue makeKeyValue(const std::string & key, const std::string & value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  return key_value;
+}
+}  // namespace
+
+TransitionProbe::TransitionProbe()
+: rss_bytes_(readResidentSetSize()), heap_bytes_(readHeapSize()),
+  allocations_(readAllocationCount()), start_(std::chrono::steady_clock::now())
+{
+}
+
+TransitionMetrics TransitionProbe::stop(
+  const std::string & transition,
+  const std::string & result) const
+{
+  auto end = std::chrono::steady_clock::now();
+  auto allocations = readAllocationCount();
+  auto heap_bytes = readHeapSize();
+  auto rss_bytes = readResidentSetSize();
+
+  TransitionMetrics metrics;
+  metrics.transition = transition;
+  metrics.result = result;
+  metrics.duration = end - start_;
+  metrics.allocations = allocations < 0 ? -1 : allocations - allocations_;
+  metrics.heap_delta_bytes = heap_bytes - heap_bytes_;
+  metrics.rss_delta_bytes = rss_bytes - rss_bytes_;
+  return metrics;
+}
+
+diagnostic_msgs::msg::DiagnosticStatus toDiagnosticStatus(
+  const TransitionMetrics & metrics, const std::string & node_name)
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = node_name + ": " + metrics.transition;
+  status.hardware_id = node_name;
+  status.level = metrics.result == "success" ?
+    diagnostic_msgs::msg::DiagnosticStatus::OK : diagnostic_msgs::msg::DiagnosticStatus::ERROR;
+  status.message = metrics.result;
+  status.values.push_back(
+    makeKeyValue(
+      "duration [ms]",
+      std::to_string(std::chrono::duration<double, std::milli>(metrics.duration).count())));
+  status.values.push_back(
+    makeKeyValue(
+      "allocations",
+      metrics.allocations < 0 ? "unknown" : std::to_string(metrics.allocations)));
+  status.values.push_back(
+    makeKeyValue("heap delta [bytes]", std::to_string(metrics.heap_delta_bytes)));
+  status.values.push_back(
+    makeKeyValue("rss delta [bytes]", std::to_string(metrics.rss_delta_bytes)));
+  return status;
+}
+}  // namespace kroshu_ros2_core
@@ -12,70 +12,724 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <memory>
+#include <vector>
 
 #include "controller_manager/controller_manager.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "rcl/arguments.h"
+#include "rcl/remap.h"
+#include "rcl_yaml_param_parser/parser.h"
+#include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/parameter_map.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "rosgraph_msgs/msg/clock.hpp"
 #include "std_msgs/msg/bool.hpp"
 
+#include "communication_helpers/serialization.hpp"
+#include "kroshu_ros2_core/ControlLoopStatistics.hpp"
+#include "kroshu_ros2_core/CycleRecorder.hpp"
+#include "kroshu_ros2_core/RealTimeLogger.hpp"
+#include "kroshu_ros2_core/RealTimeSection.hpp"
+#include "kroshu_ros2_core/RealTimeTools.hpp"
+#include "kroshu_ros2_core/SharedStatusBlock.hpp"
+
+using kroshu_ros2_core::ControlLoopStatistics;
+
+namespace
+{
+/**
+ * @brief Options of the control node, read from the parameters of the controller manager
+ */
+struct ControlNodeOptions
+{
+  std::int64_t rt_priority = 95;
+  std::vector<std::int64_t> rt_cpu_affinity;
+  std::vector<std::int64_t> executor_cpu_affinity;
+  std::int64_t executor_threads = 0;
+  std::int64_t executor_priority = 0;
+  std::string rt_callbacks_executor = "single_threaded";
+  std::int64_t rt_callbacks_priority = 0;
+  std::vector<std::int64_t> rt_callbacks_cpu_affinity;
+  bool lock_memory = false;
+  std::int64_t prefault_stack_size = 0;
+  std::int64_t prefault_heap_size = 0;
+  std::int64_t statistics_publish_period_ms = 1000;
+  std::int64_t overrun_tolerance_percent = 10;
+  bool simulated_clock = false;
+  double simulated_duration_s = 0.0;
+  std::string recorder_directory;
+  std::int64_t recorder_history_s = 10;
+  std::int64_t recorder_segment_count = 4;
+  std::string status_source = "topic";
+  std::string status_block_name = "/kroshu_robot_status";
+  std::int64_t status_watchdog_ms = 100;
+};
+
+/**
+ * @brief Fully qualified name of the node with the given name after the global remappings
+ */
+std::string resolveNodeName(const std::string & node_name, const rcl_arguments_t * global_args)
+{
+  auto allocator = rcl_get_default_allocator();
+  std::string name = node_name;
+  std::string name_space = "/";
+  char * remapped = nullptr;
+  if (rcl_remap_node_name(
+      nullptr, global_args, node_name.c_str(), allocator,
+      &remapped) == RCL_RET_OK && remapped != nullptr)
+  {
+    name = remapped;
+    allocator.deallocate(remapped, allocator.state);
+  }
+  remapped = nullptr;
+  if (rcl_remap_node_namespace(
+      nullptr, global_args, node_name.c_str(), allocator,
+      &remapped) == RCL_RET_OK && remapped != nullptr)
+  {
+    name_space = remapped;
+    allocator.deallocate(remapped, allocator.state);
+  }
+  rcl_reset_error();
+  return name_space == "/" ? "/" + name : name_space + "/" + name;
+}
+
+using ParameterOverrides = std::map<std::string, rclcpp::ParameterValue>;
+
+/**
+ * @brief Collects the parameters given to the node on the command line, without creating a node
+ *
+ * Parameters given to all nodes with the wildcard are overridden by the ones given
+ *  to the node by name, other wildcard patterns are not matched.
+ */
+ParameterOverrides getParameterOverrides(const std::string & node_name)
+{
+  ParameterOverrides overrides;
+  auto context = rclcpp::contexts::get_global_default_context()->get_rcl_context();
+  rcl_params_t * params = nullptr;
+  if (rcl_arguments_get_param_overrides(&context->global_arguments, &params) != RCL_RET_OK) {
+    rcl_reset_error();
+    return overrides;
+  }
+  if (params == nullptr) {
+    return overrides;
+  }
+  auto parameter_map = rclcpp::parameter_map_from(params);
+  rcl_yaml_node_struct_fini(params);
+
+  const std::string node_key = resolveNodeName(node_name, &context->global_arguments);
+  for (const auto & key : {std::string("/**"), node_key}) {
+    auto parameters = parameter_map.find(key);
+    if (parameters == parameter_map.end()) {
+      continue;
+    }
+    for (const auto & parameter : parameters->second) {
+      overrides[parameter.get_name()] = parameter.get_parameter_value();
+    }
+  }
+  return overrides;
+}
+
+/**
+ * @brief Overwrites the value if the parameter is given
+ *
+ * @throw rclcpp::ParameterTypeException if the parameter has a different type
+ */
+template<typename T>
+void getOption(const ParameterOverrides & overrides, const std::string & name, T & value)
+{
+  auto parameter = overrides.find(name);
+  if (parameter != overrides.end()) {
+    value = parameter->second.get<T>();
+  }
+}
+
+/**
+ * @brief Reads the options from the parameters given to the controller manager
+ *
+ * The executor has to be created before the controller manager, so the parameters
+ *  are parsed from the command line arguments instead of being read through a node.
+ */
+ControlNodeOptions loadOptions(const std::string & node_name)
+{
+  auto overrides = getParameterOverrides(node_name);
+  ControlNodeOptions options;
+  getOption(overrides, "rt_priority", options.rt_priority);
+  getOption(overrides, "rt_cpu_affinity", options.rt_cpu_affinity);
+  getOption(overrides, "executor_cpu_affinity", options.executor_cpu_affinity);
+  getOption(overrides, "executor_threads", options.executor_threads);
+  getOption(overrides, "executor_priority", options.executor_priority);
+  getOption(overrides, "rt_callbacks_executor", options.rt_callbacks_executor);
+  getOption(overrides, "rt_callbacks_priority", options.rt_callbacks_priority);
+  getOption(overrides, "rt_callbacks_cpu_affinity", options.rt_callbacks_cpu_affinity);
+  getOption(overrides, "lock_memory", options.lock_memory);
+  getOption(overrides, "prefault_stack_size", options.prefault_stack_size);
+  getOption(overrides, "prefault_heap_size", options.prefault_heap_size);
+  getOption(overrides, "statistics_publish_period_ms", options.statistics_publish_period_ms);
+  getOption(overrides, "overrun_tolerance_percent", options.overrun_tolerance_percent);
+  getOption(overrides, "simulated_clock", options.simulated_clock);
+  getOption(overrides, "simulated_duration_s", options.simulated_duration_s);
+  getOption(overrides, "recorder_directory", options.recorder_directory);
+  getOption(overrides, "recorder_history_s", options.recorder_history_s);
+  getOption(overrides, "recorder_segment_count", options.recorder_segment_count);
+  getOption(overrides, "status_source", options.status_source);
+  getOption(overrides, "status_block_name", options.status_block_name);
+  getOption(overrides, "status_watchdog_ms", options.status_watchdog_ms);
+  return options;
+}
+
+void applyProcessOptions(const ControlNodeOptions & options, const rclcpp::Logger & logger)
+{
+  if (options.lock_memory) {
+    if (kroshu_ros2_core::lockMemory()) {
+      RCLCPP_INFO(logger, "Current and future memory pages are locked");
+    } else {
+      RCLCPP_WARN(logger, "Memory could not be locked: %s", strerror(errno));
+    }
+  } else {
+    RCLCPP_INFO(logger, "Memory is not locked, page faults may cause latency spikes");
+  }
+
+  if (options.prefault_heap_size > 0) {
+    if (kroshu_ros2_core::prefaultHeap(static_cast<std::size_t>(options.prefault_heap_size))) {
+      RCLCPP_INFO(logger, "Prefaulted %" PRId64 " bytes of heap", options.prefault_heap_size);
+    } else {
+      RCLCPP_WARN(logger, "Heap could not be prefaulted: %s", strerror(errno));
+    }
+  }
+}
+
+/**
+ * @brief Sets the priority and affinity of the control loop thread and prefaults its stack
+ *
+ * The scheduling is not changed if rt_priority is not positive.
+ */
+void applyControlThreadOptions(const ControlNodeOptions & options, const rclcpp::Logger & logger)
+{
+  if (options.rt_priority <= 0) {
+    RCLCPP_INFO(logger, "Control thread runs with the default scheduling policy");
+  } else if (kroshu_ros2_core::setThreadFifoPriority(static_cast<int>(options.rt_priority))) {
+    RCLCPP_INFO(
+      logger, "Control thread runs with SCHED_FIFO priority %" PRId64,
+      options.rt_priority);
+  } else {
+    int error = errno;
+    RCLCPP_ERROR(logger, "setscheduler error: %s", strerror(error));
+    RCLCPP_WARN(logger, "You can use the driver but scheduler priority was not set");
+  }
+
+  if (options.rt_cpu_affinity.empty()) {
+    RCLCPP_INFO(logger, "Control thread is not pinned to any CPU");
+  } else if (kroshu_ros2_core::setThreadAffinity(options.rt_cpu_affinity)) {
+    RCLCPP_INFO(
+      logger, "Control thread is pinned to CPUs %s",
+      kroshu_ros2_core::cpuListToString(options.rt_cpu_affinity).c_str());
+  } else {
+    RCLCPP_WARN(logger, "Control thread could not be pinned: %s", strerror(errno));
+  }
+
+  if (options.prefault_stack_size > 0) {
+    kroshu_ros2_core::prefaultStack(static_cast<std::size_t>(options.prefault_stack_size));
+    RCLCPP_INFO(
+      logger, "Prefaulted %" PRId64 " bytes of the control thread stack",
+      options.prefault_stack_size);
+  }
+}
+
+/**
+ * @brief Sets the priority and affinity of the calling thread, used for the executor threads
+ *
+ * Threads created afterwards by the calling thread inherit these settings.
+ *
+ * @param priority: SCHED_FIFO priority, the scheduling is not changed if it is not positive
+ */
+void applyExecutorThreadOptions(
+  std::int64_t priority, const std::vector<std::int64_t> & cpu_affinity,
+  const char * thread_name, const rclcpp::Logger & logger)
+{
+  if (priority > 0) {
+    if (kroshu_ros2_core::setThreadFifoPriority(static_cast<int>(priority))) {
+      RCLCPP_INFO(
+        logger, "%s threads run with SCHED_FIFO priority %" PRId64, thread_name, priority);
+    } else {
+      RCLCPP_WARN(
+        logger, "%s threads priority could not be set: %s", thread_name,
+        strerror(errno));
+    }
+  }
+
+  if (cpu_affinity.empty()) {
+    RCLCPP_INFO(logger, "%s threads are not pinned to any CPU", thread_name);
+  } else if (kroshu_ros2_core::setThreadAffinity(cpu_affinity)) {
+    RCLCPP_INFO(
+      logger, "%s threads are pinned to CPUs %s", thread_name,
+      kroshu_ros2_core::cpuListToString(cpu_affinity).c_str());
+  } else {
+    RCLCPP_WARN(logger, "%s threads could not be pinned: %s", thread_name, strerror(errno));
+  }
+}
+
+/**
+ * @brief Creates the executor for the callbacks feeding the control loop
+ *
+ * @return nullptr, if these callbacks should be served by the main executor
+ */
+std::shared_ptr<rclcpp::Executor> createRTCallbacksExecutor(
+  const ControlNodeOptions & options, const rclcpp::Logger & logger)
+{
+  if (options.rt_callbacks_executor == "single_threaded") {
+    return std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  } else if (options.rt_callbacks_executor == "static") {
+    return std::make_shared<rclcpp::executors::StaticSingleThreadedExecutor>();
+  } else if (options.rt_callbacks_executor != "none") {
+    RCLCPP_WARN(
+      logger, "Unknown rt_callbacks_executor '%s', using the main executor",
+      options.rt_callbacks_executor.c_str());
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Creates the cycle recorder if a recorder directory is given
+ *
+ * @return nullptr, if recording is disabled or the recorder could not be created
+ */
+std::unique_ptr<kroshu_ros2_core::CycleRecorder> createCycleRecorder(
+  const ControlNodeOptions & options, int update_rate, const rclcpp::Logger & logger)
+{
+  if (options.recorder_directory.empty()) {
+    return nullptr;
+  }
+  kroshu_ros2_core::CycleRecorderOptions recorder_options;
+  recorder_options.directory = options.recorder_directory;
+  recorder_options.max_frame_size = 64;
+  recorder_options.segment_count =
+    static_cast<std::size_t>(std::max<std::int64_t>(options.recorder_segment_count, 2));
+  recorder_options.setHistory(std::chrono::seconds(options.recorder_history_s), update_rate);
+  try {
+    auto recorder = std::make_unique<kroshu_ros2_core::CycleRecorder>(recorder_options);
+    RCLCPP_INFO(
+      logger, "Recording the last %" PRId64 " s of control cycles to %s",
+      options.recorder_history_s, options.recorder_directory.c_str());
+    return recorder;
+  } catch (std::exception & e) {
+    RCLCPP_ERROR(logger, "Cycle recorder could not be created: %s", e.what());
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Everything the control loop threads share
+ */
+struct ControlLoopContext
+{
+  std::shared_ptr<controller_manager::ControllerManager> controller_manager;
+  const std::atomic_bool & is_configured;
+  kroshu_ros2_core::SharedStatusReader * status_reader;
+  std::atomic<kroshu_ros2_core::ControlMode> & control_mode;
+  ControlLoopStatistics & statistics;
+  kroshu_ros2_core::RealTimeLogger & rt_logger;
+  kroshu_ros2_core::CycleRecorder * recorder;
+  const ControlNodeOptions & options;
+  rclcpp::Duration dt;
+  std::chrono::nanoseconds period;
+};
+
+/**
+ * @brief Returns whether the hardware is configured, real-time safe
+ *
+ * With the shared status block, the block is read in every cycle and a stale heartbeat
+ *  counts as not configured, so the hardware is left alone if the robot manager hangs.
+ * The control mode of the block is only reported: it is stored for the statistics
+ *  and its changes are logged, the controllers are still switched by the robot manager.
+ * Must be called from one thread only, the one reading the hardware.
+ */
+bool readIsConfigured(const ControlLoopContext & context)
+{
+  if (context.status_reader == nullptr) {
+    return context.is_configured;
+  }
+  bool was_alive = context.status_reader->isAlive();
+  auto status = context.status_reader->read();
+  if (was_alive && !context.status_reader->isAlive()) {
+    KROSHU_RT_LOG_ERROR(
+      context.rt_logger, "Heartbeat of the robot manager lost, hardware is not read or written");
+  } else if (!was_alive && context.status_reader->isAlive()) {
+    KROSHU_RT_LOG_INFO(context.rt_logger, "Heartbeat of the robot manager received");
+  }
+  if (status.control_mode != context.control_mode.load(std::memory_order_relaxed)) {
+    context.control_mode.store(status.control_mode, std::memory_order_relaxed);
+    KROSHU_RT_LOG_INFO(
+      context.rt_logger, "Control mode of the robot manager changed to %d",
+      static_cast<int>(status.control_mode));
+  }
+  return status.is_configured;
+}
+
+/**
+ * @brief Records the phase durations of a cycle, frame layout:
+ *  configured flag, read, update and write duration [ns], all serialized as int
+ */
+void recordCycle(
+  kroshu_ros2_core::CycleRecorder * recorder, std::chrono::steady_clock::time_point cycle_start,
+  bool configured, std::chrono::nanoseconds read, std::chrono::nanoseconds update,
+  std::chrono::nanoseconds write)
+{
+  if (recorder == nullptr) {
+    return;
+  }
+  auto frame = recorder->beginFrame(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      cycle_start.time_since_epoch()).count());
+  if (frame == nullptr) {
+    return;
+  }
+  kroshu_ros2_core::serializeNext(configured ? 1 : 0, *frame);
+  kroshu_ros2_core::serializeNext(static_cast<int>(read.count()), *frame);
+  kroshu_ros2_core::serializeNext(static_cast<int>(update.count()), *frame);
+  kroshu_ros2_core::serializeNext(static_cast<int>(write.count()), *frame);
+  recorder->commitFrame();
+}
+
+/**
+ * @brief Runs read, update and write one after the other on the calling thread
+ */
+void runSerialLoop(const ControlLoopContext & context)
+{
+  auto & controller_manager = context.controller_manager;
+  auto & statistics = context.statistics;
+  const auto & dt = context.dt;
+  while (rclcpp::ok()) {
+    auto cycle_start = std::chrono::steady_clock::now();
+    if (readIsConfigured(context)) {
+      KROSHU_RT_SECTION();
+      controller_manager->read(controller_manager->now(), dt);
+      auto read_end = std::chrono::steady_clock::now();
+      controller_manager->update(controller_manager->now(), dt);
+      auto update_end = std::chrono::steady_clock::now();
+      controller_manager->write(controller_manager->now(), dt);
+      auto write_end = std::chrono::steady_clock::now();
+      statistics.recordPhase(ControlLoopStatistics::Phase::READ, read_end - cycle_start);
+      statistics.recordPhase(ControlLoopStatistics::Phase::UPDATE, update_end - read_end);
+      statistics.recordPhase(ControlLoopStatistics::Phase::WRITE, write_end - update_end);
+      statistics.recordCycle(cycle_start, read_end, write_end);
+      recordCycle(
+        context.recorder, cycle_start, true, read_end - cycle_start, update_end - read_end,
+        write_end - update_end);
+    } else {
+      {
+        KROSHU_RT_SECTION();
+        controller_manager->update(controller_manager->now(), dt);
+        auto update_end = std::chrono::steady_clock::now();
+        // Idle cycles are paced by the sleep, not by the hardware, so they are not part
+        //  of the statistics and the next configured cycle starts a new start-to-start chain
+        statistics.restartCycles();
+        recordCycle(
+          context.recorder, cycle_start, false, std::chrono::nanoseconds::zero(),
+          update_end - cycle_start, std::chrono::nanoseconds::zero());
+      }
+      std::this_thread::sleep_until(cycle_start + context.period);
+    }
+  }
+}
+
+/**
+ * @brief Runs read, update and write on a simulated clock as fast as possible
+ *
+ * The clock is seeded with the current system time, as the ROS time of a node with use_sim_time
+ *  is zero until the first /clock message. It advances by exactly dt every cycle without sleeping,
+ *  the hardware is always read and written, as mock hardware has no robot manager.
+ * The simulated time is published on /clock before every cycle, so the controller manager
+ *  must run with use_sim_time and be the only /clock publisher. Other nodes only follow
+ *  the simulated time if they also set use_sim_time.
+ * The node shuts down after simulated_duration_s of simulated time.
+ *
+ * @throw std::runtime_error if use_sim_time is not set or simulated_duration_s is not positive
+ */
+void runSimulatedClockLoop(const ControlLoopContext & context)
+{
+  auto & controller_manager = context.controller_manager;
+  auto & statistics = context.statistics;
+  const auto & dt = context.dt;
+  if (!controller_manager->get_parameter("use_sim_time").as_bool()) {
+    throw std::runtime_error("The simulated clock mode requires use_sim_time");
+  }
+  // The loop never sleeps, so it must not run unbounded
+  if (context.options.simulated_duration_s <= 0.0) {
+    throw std::runtime_error("The simulated clock mode requires a positive simulated_duration_s");
+  }
+  auto clock_pub = controller_manager->create_publisher<rosgraph_msgs::msg::Clock>(
+    "/clock", rclcpp::ClockQoS());
+  rosgraph_msgs::msg::Clock clock_msg;
+
+  const rclcpp::Time start_time(
+    rclcpp::Clock(RCL_SYSTEM_TIME).now().nanoseconds(), RCL_ROS_TIME);
+  const auto end_time = start_time + rclcpp::Duration::from_seconds(
+    context.options.simulated_duration_s);
+  const auto wall_start = std::chrono::steady_clock::now();
+  auto time = start_time;
+  while (rclcpp::ok() && time < end_time) {
+    // Published outside of the real-time section, the loop does not run in real time anyway
+    clock_msg.clock = time;
+    clock_pub->publish(clock_msg);
+
+    KROSHU_RT_SECTION();
+    auto cycle_start = std::chrono::steady_clock::now();
+    controller_manager->read(time, dt);
+    auto read_end = std::chrono::steady_clock::now();
+    controller_manager->update(time, dt);
+    auto update_end = std::chrono::steady_clock::now();
+    controller_manager->write(time, dt);
+    auto write_end = std::chrono::steady_clock::now();
+    statistics.recordPhase(ControlLoopStatistics::Phase::READ, read_end - cycle_start);
+    statistics.recordPhase(ControlLoopStatistics::Phase::UPDATE, update_end - read_end);
+    statistics.recordPhase(ControlLoopStatistics::Phase::WRITE, write_end - update_end);
+    // No overruns or jitter without pacing, the cycle is the compute time here
+    statistics.recordPhase(ControlLoopStatistics::Phase::CYCLE, write_end - cycle_start);
+    statistics.recordPhase(ControlLoopStatistics::Phase::COMPUTE, write_end - read_end);
+    recordCycle(
+      context.recorder, cycle_start, true, read_end - cycle_start, update_end - read_end,
+      write_end - update_end);
+    time += dt;
+  }
+
+  std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+  double simulated_time = (time - start_time).seconds();
+  RCLCPP_INFO(
+    controller_manager->get_logger(),
+    "Simulated %.3f s in %.3f s of wall time (%.1fx real time)", simulated_time,
+    wall_time.count(), wall_time.count() > 0.0 ? simulated_time / wall_time.count() : 0.0);
+  rclcpp::shutdown();
+}
+
+diagnostic_msgs::msg::KeyValue makeKeyValue(const std::string & key, const std::string & value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  return key_value;
+}
+
+diagnostic_msgs::msg::DiagnosticStatus statisticsToStatus(
+  const ControlLoopStatistics & statistics, std::uint64_t previous_overruns)
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = "control_loop";
+  status.hardware_id = "controller_manager";
+  auto overruns = statistics.getOverrunCount();
+  if (overruns > previous_overruns) {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    status.message = std::to_string(overruns - previous_overruns) + " overruns since last report";
+  } else {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.message = "No overruns since last report";
+  }
+  status.values.push_back(
+    makeKeyValue("period [us]", std::to_string(statistics.getPeriod().count() / 1000)));
+  status.values.push_back(makeKeyValue("overruns", std::to_string(overruns)));
+  for (std::size_t i = 0; i < ControlLoopStatistics::PHASE_COUNT; ++i) {
+    auto phase = static_cast<ControlLoopStatistics::Phase>(i);
+    auto snapshot = statistics.getHistogram(phase).snapshot();
+    std::string prefix = ControlLoopStatistics::phaseName(phase);
+    status.values.push_back(makeKeyValue(prefix + " samples", std::to_string(snapshot.count)));
+    status.values.push_back(
+      makeKeyValue(prefix + " mean [us]", std::to_string(snapshot.mean() / 1000.0)));
+    status.values.push_back(
+      makeKeyValue(prefix + " p99 [us]", std::to_string(snapshot.quantile(0.99) / 1000)));
+    status.values.push_back(
+      makeKeyValue(prefix + " max [us]", std::to_string(snapshot.max_ns / 1000)));
+  }
+  return status;
+}
+}  // namespace
 
 int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
-  auto executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>();
+  const auto options = loadOptions("controller_manager");
+
+  // Services, parameter events and controller callbacks share a bounded pool,
+  //  the callbacks feeding the control loop get their own executor if configured
+  auto executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(
+    rclcpp::ExecutorOptions(), static_cast<std::size_t>(std::max<std::int64_t>(
+      options.executor_threads, 0)));
   auto controller_manager = std::make_shared<controller_manager::ControllerManager>(
     executor,
     "controller_manager");
+  auto rt_callbacks_executor = createRTCallbacksExecutor(options, controller_manager->get_logger());
+  RCLCPP_INFO(
+    controller_manager->get_logger(), "Main executor uses %zu threads",
+    executor->get_number_of_threads());
+
+  applyProcessOptions(options, controller_manager->get_logger());
 
   auto qos = rclcpp::QoS(rclcpp::KeepLast(1));
   qos.best_effort();
 
+  rclcpp::SubscriptionOptions rt_callbacks_options;
+  rclcpp::CallbackGroup::SharedPtr rt_callback_group;
+  if (rt_callbacks_executor) {
+    rt_callback_group = controller_manager->create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, false);
+    rt_callbacks_options.callback_group = rt_callback_group;
+  }
+
+  // The configuration state comes from the robot manager through a topic or a shared memory
+  //  block, the latter is read by the control loop in every cycle without DDS in between
   std::atomic_bool is_configured = false;
-  auto is_configured_sub = controller_manager->create_subscription<std_msgs::msg::Bool>(
-    "robot_manager/is_configured", qos,
-    [&is_configured](std_msgs::msg::Bool::SharedPtr msg) {
-      is_configured = msg->data;
-    });
+  std::atomic<kroshu_ros2_core::ControlMode> control_mode {
+    kroshu_ros2_core::ControlMode::UNSPECIFIED_CONTROL_MODE};
+  rclcpp::Subscription<std_msgs::msg::Bool>::SharedPtr is_configured_sub;
+  std::unique_ptr<kroshu_ros2_core::SharedStatusReader> status_reader;
+  rclcpp::TimerBase::SharedPtr status_attach_timer;
+  if (options.status_source == "shared_memory") {
+    status_reader = std::make_unique<kroshu_ros2_core::SharedStatusReader>(
+      options.status_block_name, std::chrono::milliseconds(options.status_watchdog_ms));
+    // The robot manager may start later, attaching is retried until the block exists
+    status_attach_timer = controller_manager->create_wall_timer(
+      std::chrono::milliseconds(100),
+      [&status_reader, &status_attach_timer, &options, controller_manager]() {
+        if (status_reader->attach()) {
+          RCLCPP_INFO(
+            controller_manager->get_logger(), "Attached to the status block %s",
+            options.status_block_name.c_str());
+          status_attach_timer->cancel();
+        } else {
+          RCLCPP_INFO_ONCE(
+            controller_manager->get_logger(), "Waiting for the status block %s",
+            options.status_block_name.c_str());
+        }
+      });
+  } else {
+    if (options.status_source != "topic") {
+      RCLCPP_WARN(
+        controller_manager->get_logger(), "Unknown status_source '%s', using the topic",
+        options.status_source.c_str());
+    }
+    is_configured_sub = controller_manager->create_subscription<std_msgs::msg::Bool>(
+      "robot_manager/is_configured", qos,
+      [&is_configured](std_msgs::msg::Bool::SharedPtr msg) {
+        is_configured = msg->data;
+      }, rt_callbacks_options);
+  }
 
+  const rclcpp::Duration dt =
+    rclcpp::Duration::from_seconds(1.0 / controller_manager->get_update_rate());
+  const std::chrono::nanoseconds period {dt.nanoseconds()};
+
+  // Statistics are written by the control loop and published from the executor threads,
+  //  cycles longer than the period by more than the tolerance are counted as overruns
+  ControlLoopStatistics statistics(period, period * options.overrun_tolerance_percent / 100);
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr statistics_pub;
+  rclcpp::TimerBase::SharedPtr statistics_timer;
+  std::uint64_t published_overruns = 0;
+  if (options.statistics_publish_period_ms > 0) {
+    statistics_pub = controller_manager->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+      "~/control_loop_statistics", rclcpp::SystemDefaultsQoS());
+    statistics_timer = controller_manager->create_wall_timer(
+      std::chrono::milliseconds(options.statistics_publish_period_ms),
+      [&statistics, &statistics_pub, &published_overruns, &status_reader, &control_mode,
+      controller_manager]() {
+        diagnostic_msgs::msg::DiagnosticArray msg;
+        msg.header.stamp = controller_manager->now();
+        msg.status.push_back(statisticsToStatus(statistics, published_overruns));
+        published_overruns = statistics.getOverrunCount();
+        if (status_reader) {
+          msg.status.back().values.push_back(
+            makeKeyValue(
+              "robot manager control mode",
+              std::to_string(static_cast<int>(control_mode.load(std::memory_order_relaxed)))));
+        }
+        statistics_pub->publish(msg);
+      },
+      controller_manager->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive));
+  }
 
-  std::thread control_loop([controller_manager, &is_configured]() {
-      struct sched_param param;
-      param.sched_priority = 95;
-      if (sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
-        RCLCPP_ERROR(controller_manager->get_logger(), "setscheduler error");
-        RCLCPP_ERROR(controller_manager->get_logger(), strerror(errno));
-        RCLCPP_WARN(
+  // The control loop logs through a lock-free queue drained by a background thread
+  kroshu_ros2_core::RealTimeLogger rt_logger(controller_manager->get_logger().get_name());
+  // The recorder is frozen if the loop quits, so the files keep the cycles before the error
+  auto recorder = createCycleRecorder(
+    options, controller_manager->get_update_rate(),
+    controller_manager->get_logger());
+  ControlLoopContext context {
+    controller_manager, is_configured, status_reader.get(), control_mode, statistics, rt_logger,
+    recorder.get(), options, dt, period};
+  std::thread control_loop(
+    [&context]() {
+      auto & controller_manager = context.controller_manager;
+      // The simulated loop never sleeps, it must not starve the other threads of its CPU
+      if (context.options.simulated_clock) {
+        RCLCPP_INFO(
           controller_manager->get_logger(),
-          "You can use the driver but scheduler priority was not set");
+          "Simulated clock mode: the control thread keeps the default scheduling and affinity");
+      } else {
+        applyControlThreadOptions(context.options, controller_manager->get_logger());
       }
 
-      const rclcpp::Duration dt =
-      rclcpp::Duration::from_seconds(1.0 / controller_manager->get_update_rate());
-      std::chrono::milliseconds dt_ms {1000 / controller_manager->get_update_rate()};
-
       try {
-        while (rclcpp::ok()) {
-          if (is_configured) {
-            controller_manager->read(controller_manager->now(), dt);
-            controller_manager->update(controller_manager->now(), dt);
-            controller_manager->write(controller_manager->now(), dt);
-          } else {
-            controller_manager->update(controller_manager->now(), dt);
-            std::this_thread::sleep_for(dt_ms);
-          }
+        if (context.options.simulated_clock) {
+          RCLCPP_INFO(
+            controller_manager->get_logger(),
+            "Simulated clock mode: the loop runs as fast as possible with a step of %.6f s",
+            context.dt.seconds());
+          RCLCPP_WARN(
+            controller_manager->get_logger(),
+            "Simulated clock mode: the configuration state of the robot manager is ignored, "
+            "the hardware is read and written in every cycle");
+          runSimulatedClockLoop(context);
+        } else {
+          runSerialLoop(context);
         }
       } catch (std::exception & e) {
-        RCLCPP_ERROR(
-          controller_manager->get_logger(), "Quitting control loop due to: %s",
-          e.what());
+        KROSHU_RT_LOG_ERROR(context.rt_logger, "Quitting control loop due to: %s", e.what());
+        if (context.recorder != nullptr) {
+          context.recorder->freeze();
+        }
       }
     });
 
+  std::thread rt_callbacks_thread;
+  if (rt_callbacks_executor) {
+    rt_callbacks_executor->add_callback_group(
+      rt_callback_group, controller_manager->get_node_base_interface());
+    rt_callbacks_thread = std::thread(
+      [&options, &rt_callbacks_executor, &controller_manager]() {
+        applyExecutorThreadOptions(
+          options.rt_callbacks_priority, options.rt_callbacks_cpu_affinity,
+          "Control loop callback", controller_manager->get_logger());
+        rt_callbacks_executor->spin();
+      });
+  }
+
+  applyExecutorThreadOptions(
+    options.executor_priority, options.executor_cpu_affinity, "Executor",
+    controller_manager->get_logger());
   executor->add_node(controller_manager);
 
   executor->spin();
   control_loop.join();
+  if (rt_callbacks_thread.joinable()) {
+    rt_callbacks_executor->cancel();
+    rt_callbacks_thread.join();
+  }
+
+  // Dump the statistics of the whole run
+  auto summary = statisticsToStatus(statistics, 0);
+  RCLCPP_INFO(controller_manager->get_logger(), "Control loop statistics:");
+  for (const auto & key_value : summary.values) {
+    RCLCPP_INFO(
+      controller_manager->get_logger(), "  %s: %s", key_value.key.c_str(),
+      key_value.value.c_str());
+  }
 
   // shutdown
   rclcpp::shutdown();
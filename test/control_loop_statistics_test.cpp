@@ -0,0 +1,152 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "kroshu_ros2_core/ControlLoopStatistics.hpp"
+
+using kroshu_ros2_core::ControlLoopStatistics;
+using kroshu_ros2_core::LatencyHistogram;
+
+namespace
+{
+std::chrono::steady_clock::time_point at(std::int64_t microseconds)
+{
+  return std::chrono::steady_clock::time_point() + std::chrono::microseconds(microseconds);
+}
+}  // namespace
+
+TEST(LatencyHistogramTest, BucketBoundaries)
+{
+  // Below SUB_BUCKET_COUNT every microsecond has its own bucket
+  for (std::uint64_t us = 0; us < LatencyHistogram::SUB_BUCKET_COUNT; ++us) {
+    EXPECT_EQ(LatencyHistogram::bucketIndex(us), us);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(us), us + 1);
+  }
+  // Every power of two is split into four buckets of equal width
+  EXPECT_EQ(LatencyHistogram::bucketIndex(4), 4u);
+  EXPECT_EQ(LatencyHistogram::bucketUpperBound(4), 5u);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(8), 8u);
+  EXPECT_EQ(LatencyHistogram::bucketUpperBound(8), 10u);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(1000), 35u);
+  EXPECT_EQ(LatencyHistogram::bucketUpperBound(34), 896u);
+  EXPECT_EQ(LatencyHistogram::bucketUpperBound(35), 1024u);
+
+  // The buckets are contiguous: each one ends where the next one starts
+  for (std::size_t i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; ++i) {
+    auto upper_bound = LatencyHistogram::bucketUpperBound(i);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(upper_bound - 1), i) << "bucket " << i;
+    EXPECT_EQ(LatencyHistogram::bucketIndex(upper_bound), i + 1) << "bucket " << i;
+  }
+}
+
+TEST(LatencyHistogramTest, LargeValuesAreCountedInTheLastBucket)
+{
+  const std::size_t last = LatencyHistogram::BUCKET_COUNT - 1;
+  auto range_end = LatencyHistogram::bucketUpperBound(last);
+  EXPECT_EQ(range_end, 131072u);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(range_end - 1), last);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(range_end), last);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(std::uint64_t{1} << 40), last);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(std::numeric_limits<std::uint64_t>::max()), last);
+
+  LatencyHistogram histogram;
+  histogram.record(std::chrono::seconds(10));
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.buckets[last], 1u);
+  // The quantile is limited by the maximum, not by the bound of the last bucket
+  EXPECT_EQ(snapshot.quantile(0.5), std::chrono::nanoseconds(std::chrono::seconds(10)).count());
+}
+
+TEST(LatencyHistogramTest, QuantilesAndMean)
+{
+  LatencyHistogram histogram;
+  auto empty = histogram.snapshot();
+  EXPECT_EQ(empty.count, 0u);
+  EXPECT_EQ(empty.mean(), 0.0);
+  EXPECT_EQ(empty.quantile(0.5), 0);
+
+  for (int i = 0; i < 90; ++i) {
+    histogram.record(std::chrono::microseconds(100));
+  }
+  for (int i = 0; i < 10; ++i) {
+    histogram.record(std::chrono::microseconds(1000));
+  }
+  // Negative durations are recorded as zero
+  histogram.record(std::chrono::nanoseconds(-5));
+
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 101u);
+  EXPECT_EQ(snapshot.buckets[0], 1u);
+  EXPECT_EQ(snapshot.buckets[LatencyHistogram::bucketIndex(100)], 90u);
+  EXPECT_EQ(snapshot.buckets[LatencyHistogram::bucketIndex(1000)], 10u);
+  EXPECT_EQ(snapshot.max_ns, 1000000);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), (90 * 100000.0 + 10 * 1000000.0) / 101);
+
+  // 100 us falls into [96, 112) us, the quantiles report the upper bound of the bucket
+  EXPECT_EQ(snapshot.quantile(0.0), 1000);
+  EXPECT_EQ(snapshot.quantile(0.5), 112000);
+  EXPECT_EQ(snapshot.quantile(0.85), 112000);
+  // 1000 us falls into [896, 1024) us, the bound is limited by the maximum
+  EXPECT_EQ(snapshot.quantile(0.95), 1000000);
+  EXPECT_EQ(snapshot.quantile(1.0), 1000000);
+  EXPECT_EQ(snapshot.quantile(2.0), 1000000);
+}
+
+TEST(ControlLoopStatisticsTest, CyclesAreMeasuredStartToStart)
+{
+  ControlLoopStatistics statistics(std::chrono::milliseconds(1), std::chrono::microseconds(100));
+  const auto & cycle = statistics.getHistogram(ControlLoopStatistics::Phase::CYCLE);
+  const auto & jitter = statistics.getHistogram(ControlLoopStatistics::Phase::WAKE_UP_JITTER);
+  const auto & compute = statistics.getHistogram(ControlLoopStatistics::Phase::COMPUTE);
+
+  // The first cycle has no predecessor, only its compute time is recorded
+  statistics.recordCycle(at(0), at(400), at(600));
+  EXPECT_EQ(cycle.snapshot().count, 0u);
+  EXPECT_EQ(compute.snapshot().max_ns, 200000);
+
+  // Within the tolerance
+  statistics.recordCycle(at(1000), at(1400), at(1600));
+  statistics.recordCycle(at(2050), at(2450), at(2650));
+  EXPECT_EQ(statistics.getOverrunCount(), 0u);
+  // Above the tolerance
+  statistics.recordCycle(at(3250), at(3650), at(3850));
+  EXPECT_EQ(statistics.getOverrunCount(), 1u);
+  EXPECT_EQ(cycle.snapshot().count, 3u);
+  EXPECT_EQ(cycle.snapshot().max_ns, 1200000);
+  EXPECT_EQ(jitter.snapshot().max_ns, 200000);
+  EXPECT_EQ(compute.snapshot().count, 4u);
+}
+
+TEST(ControlLoopStatisticsTest, RestartedCycleIsNotComparedWithThePreviousOne)
+{
+  ControlLoopStatistics statistics(std::chrono::milliseconds(1), std::chrono::microseconds(100));
+  const auto & cycle = statistics.getHistogram(ControlLoopStatistics::Phase::CYCLE);
+  statistics.recordCycle(at(0), at(400), at(600));
+  statistics.recordCycle(at(1000), at(1400), at(1600));
+
+  // Idle cycles in between are not recorded
+  statistics.restartCycles();
+  statistics.recordCycle(at(50000), at(50400), at(50600));
+  EXPECT_EQ(cycle.snapshot().count, 1u);
+  EXPECT_EQ(statistics.getOverrunCount(), 0u);
+
+  statistics.recordCycle(at(51000), at(51400), at(51600));
+  EXPECT_EQ(cycle.snapshot().count, 2u);
+  EXPECT_EQ(cycle.snapshot().max_ns, 1000000);
+}
@@ -0,0 +1,231 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "communication_helpers/serialization.hpp"
+#include "kroshu_ros2_core/CycleRecorder.hpp"
+
+using kroshu_ros2_core::CycleRecorder;
+using kroshu_ros2_core::CycleRecorderOptions;
+
+namespace
+{
+// Frame header: payload size, sequence number and time stamp
+constexpr std::size_t kFrameHeaderSize = 4 + 8 + 8;
+constexpr std::size_t kSegmentHeaderSize = 8 + 8;
+constexpr std::size_t kPayloadSize = 2 * sizeof(int);
+
+struct RecordedFrame
+{
+  std::uint64_t generation;
+  std::uint64_t sequence;
+  std::int64_t stamp_ns;
+  std::vector<std::uint8_t> payload;
+};
+
+// Parses the segment files as documented at CycleRecorder
+std::vector<RecordedFrame> readSegments(const CycleRecorderOptions & options)
+{
+  std::vector<RecordedFrame> frames;
+  for (std::size_t i = 0; i < options.segment_count; ++i) {
+    std::ifstream file(
+      options.directory + "/" + options.prefix + "_" + std::to_string(i) + ".bin",
+      std::ios::binary);
+    std::vector<std::uint8_t> data(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(data.size(), options.segment_size);
+    // Segments that were not started yet are still empty
+    if (data.size() < kSegmentHeaderSize || std::memcmp(data.data(), "KRSHCYC1", 8) != 0) {
+      continue;
+    }
+    RecordedFrame frame;
+    std::memcpy(&frame.generation, data.data() + 8, sizeof(frame.generation));
+    std::size_t offset = kSegmentHeaderSize;
+    while (offset + 4 <= data.size()) {
+      std::uint32_t payload_size;
+      std::memcpy(&payload_size, data.data() + offset, sizeof(payload_size));
+      if (payload_size == 0) {
+        break;
+      }
+      std::memcpy(&frame.sequence, data.data() + offset + 4, sizeof(frame.sequence));
+      std::memcpy(&frame.stamp_ns, data.data() + offset + 12, sizeof(frame.stamp_ns));
+      auto payload = data.begin() + offset + kFrameHeaderSize;
+      frame.payload.assign(payload, payload + payload_size);
+      frames.push_back(frame);
+      offset += kFrameHeaderSize + payload_size;
+    }
+  }
+  std::sort(
+    frames.begin(), frames.end(), [](const RecordedFrame & a, const RecordedFrame & b) {
+      return a.sequence < b.sequence;
+    });
+  return frames;
+}
+
+std::vector<std::uint8_t> payload(int cycle)
+{
+  std::vector<std::uint8_t> data;
+  kroshu_ros2_core::serializeNext(cycle, data);
+  kroshu_ros2_core::serializeNext(-cycle, data);
+  return data;
+}
+
+bool record(CycleRecorder & recorder, int cycle)
+{
+  auto frame = recorder.beginFrame(1000 * cycle);
+  if (frame == nullptr) {
+    return false;
+  }
+  *frame = payload(cycle);
+  recorder.commitFrame();
+  return true;
+}
+
+bool waitForWritten(const CycleRecorder & recorder, std::uint64_t count)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (recorder.getWrittenCount() < count) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+class CycleRecorderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char directory[] = "/tmp/cycle_recorder_test_XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    options_.directory = directory;
+    options_.max_frame_size = kPayloadSize;
+    options_.writer_period = std::chrono::milliseconds(1);
+    options_.segment_count = 3;
+    // Every segment holds exactly four frames
+    options_.segment_size = kSegmentHeaderSize + 4 * (kFrameHeaderSize + kPayloadSize) + 4;
+  }
+
+  void TearDown() override
+  {
+    for (std::size_t i = 0; i < options_.segment_count; ++i) {
+      auto path = options_.directory + "/" + options_.prefix + "_" + std::to_string(i) + ".bin";
+      unlink(path.c_str());
+    }
+    rmdir(options_.directory.c_str());
+  }
+
+  CycleRecorderOptions options_;
+};
+
+TEST_F(CycleRecorderTest, SegmentContents)
+{
+  {
+    CycleRecorder recorder(options_);
+    for (int cycle = 0; cycle < 3; ++cycle) {
+      ASSERT_TRUE(record(recorder, cycle));
+    }
+    ASSERT_TRUE(waitForWritten(recorder, 3));
+  }
+
+  auto frames = readSegments(options_);
+  ASSERT_EQ(frames.size(), 3u);
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    const auto & frame = frames[cycle];
+    EXPECT_EQ(frame.generation, 0u);
+    EXPECT_EQ(frame.sequence, static_cast<std::uint64_t>(cycle));
+    EXPECT_EQ(frame.stamp_ns, 1000 * cycle);
+    EXPECT_EQ(frame.payload, payload(cycle));
+  }
+}
+
+TEST_F(CycleRecorderTest, OldestSegmentIsOverwritten)
+{
+  {
+    CycleRecorder recorder(options_);
+    for (int cycle = 0; cycle < 20; ++cycle) {
+      ASSERT_TRUE(record(recorder, cycle));
+    }
+    ASSERT_TRUE(waitForWritten(recorder, 20));
+    EXPECT_EQ(recorder.getDroppedCount(), 0u);
+  }
+
+  // Segments 0 and 1 were reused for frames 12-19, segment 2 still holds frames 8-11
+  auto frames = readSegments(options_);
+  ASSERT_EQ(frames.size(), 12u);
+  for (std::size_t i = 0; i < frames.size(); ++i) {
+    const auto & frame = frames[i];
+    EXPECT_EQ(frame.sequence, 8 + i);
+    EXPECT_EQ(frame.generation, 2 + i / 4);
+    EXPECT_EQ(frame.payload, payload(static_cast<int>(frame.sequence)));
+  }
+}
+
+TEST_F(CycleRecorderTest, FreezeKeepsTheHistory)
+{
+  CycleRecorder recorder(options_);
+  for (int cycle = 0; cycle < 6; ++cycle) {
+    ASSERT_TRUE(record(recorder, cycle));
+  }
+  recorder.freeze();
+  EXPECT_TRUE(recorder.isFrozen());
+  // Frames committed before the freeze are still written
+  ASSERT_TRUE(waitForWritten(recorder, 6));
+
+  for (int cycle = 6; cycle < 20; ++cycle) {
+    EXPECT_FALSE(record(recorder, cycle));
+  }
+  EXPECT_EQ(recorder.getDroppedCount(), 0u);
+  auto frames = readSegments(options_);
+  ASSERT_EQ(frames.size(), 6u);
+  EXPECT_EQ(frames.back().sequence, 5u);
+
+  recorder.unfreeze();
+  EXPECT_TRUE(record(recorder, 6));
+  ASSERT_TRUE(waitForWritten(recorder, 7));
+  EXPECT_EQ(readSegments(options_).back().sequence, 6u);
+}
+
+TEST_F(CycleRecorderTest, FramesAreDroppedIfTheQueueIsFull)
+{
+  options_.queue_length = 2;
+  options_.writer_period = std::chrono::milliseconds(200);
+  CycleRecorder recorder(options_);
+  // The writer thread is asleep after its first empty pass
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(record(recorder, 0));
+  EXPECT_TRUE(record(recorder, 1));
+  EXPECT_FALSE(record(recorder, 2));
+  EXPECT_EQ(recorder.getDroppedCount(), 1u);
+
+  ASSERT_TRUE(waitForWritten(recorder, 2));
+  EXPECT_TRUE(record(recorder, 3));
+}
@@ -0,0 +1,142 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "communication_helpers/delta_encoding.hpp"
+
+using kroshu_ros2_core::DeltaDecoder;
+using kroshu_ros2_core::DeltaEncoder;
+
+namespace
+{
+const std::vector<double> kQuanta = {1e-6, 1e-6, 1e-4, 1e-3};
+constexpr std::size_t kKeyframeInterval = 10;
+
+// Smooth joint trajectory with a different frequency on every channel
+std::vector<double> trajectoryPoint(std::size_t cycle)
+{
+  std::vector<double> values(kQuanta.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = (1.0 + static_cast<double>(i)) * std::sin(0.001 * (1.0 + i) * cycle);
+  }
+  return values;
+}
+
+// Encodes every frame of the trajectory into its own buffer
+std::vector<std::vector<std::uint8_t>> encodeTrajectory(std::size_t cycles)
+{
+  DeltaEncoder encoder(kQuanta, kKeyframeInterval);
+  std::vector<std::vector<std::uint8_t>> frames(cycles);
+  for (std::size_t cycle = 0; cycle < cycles; ++cycle) {
+    EXPECT_GT(encoder.encodeNext(trajectoryPoint(cycle), frames[cycle]), 0);
+  }
+  return frames;
+}
+}  // namespace
+
+TEST(DeltaEncodingTest, RoundTripStaysWithinHalfQuantum)
+{
+  DeltaEncoder encoder(kQuanta, kKeyframeInterval);
+  DeltaDecoder decoder(kQuanta);
+  std::vector<std::uint8_t> stream;
+  std::vector<double> decoded(kQuanta.size());
+  // Longer than the counter period, so the counter wraps around
+  for (std::size_t cycle = 0; cycle < 1000; ++cycle) {
+    stream.clear();
+    auto values = trajectoryPoint(cycle);
+    auto size = encoder.encodeNext(values, stream);
+    ASSERT_GT(size, 0);
+    ASSERT_LE(static_cast<std::size_t>(size), encoder.maxFrameSize());
+    ASSERT_EQ(decoder.decodeNext(stream, decoded), size) << "cycle " << cycle;
+    for (std::size_t i = 0; i < kQuanta.size(); ++i) {
+      EXPECT_LE(std::fabs(decoded[i] - values[i]), 0.5 * kQuanta[i] * (1.0 + 1e-9));
+    }
+  }
+}
+
+TEST(DeltaEncodingTest, DroppedFrameIsRejectedUntilKeyframe)
+{
+  auto frames = encodeTrajectory(3 * kKeyframeInterval);
+  DeltaDecoder decoder(kQuanta);
+  std::vector<double> decoded(kQuanta.size());
+  for (std::size_t cycle = 0; cycle < 3; ++cycle) {
+    ASSERT_GT(decoder.decodeNext(frames[cycle], decoded), 0);
+  }
+
+  // Frame 3 is lost, the delta frames are rejected until the keyframe of the next interval
+  std::vector<double> unchanged = decoded;
+  for (std::size_t cycle = 4; cycle < kKeyframeInterval; ++cycle) {
+    EXPECT_EQ(decoder.decodeNext(frames[cycle], decoded), 0) << "cycle " << cycle;
+    EXPECT_EQ(decoded, unchanged);
+  }
+  for (std::size_t cycle = kKeyframeInterval; cycle < 3 * kKeyframeInterval; ++cycle) {
+    ASSERT_GT(decoder.decodeNext(frames[cycle], decoded), 0) << "cycle " << cycle;
+    auto values = trajectoryPoint(cycle);
+    for (std::size_t i = 0; i < kQuanta.size(); ++i) {
+      EXPECT_NEAR(decoded[i], values[i], 0.5 * kQuanta[i] * (1.0 + 1e-9));
+    }
+  }
+}
+
+TEST(DeltaEncodingTest, TruncatedFrameIsRejected)
+{
+  auto frames = encodeTrajectory(2 * kKeyframeInterval);
+  DeltaDecoder decoder(kQuanta);
+  std::vector<double> decoded(kQuanta.size());
+  ASSERT_GT(decoder.decodeNext(frames[0], decoded), 0);
+  ASSERT_GT(decoder.decodeNext(frames[1], decoded), 0);
+
+  auto truncated = frames[2];
+  truncated.pop_back();
+  EXPECT_EQ(decoder.decodeNext(truncated, decoded), 0);
+  EXPECT_EQ(decoder.decodeNext(std::vector<std::uint8_t>(), decoded), 0);
+  // The prediction is lost with the truncated frame, the complete one is not decoded either
+  EXPECT_EQ(decoder.decodeNext(frames[2], decoded), 0);
+  EXPECT_EQ(decoder.decodeNext(frames[3], decoded), 0);
+  EXPECT_GT(decoder.decodeNext(frames[kKeyframeInterval], decoded), 0);
+}
+
+TEST(DeltaEncodingTest, UnrepresentableValuesAreNotEncoded)
+{
+  DeltaEncoder encoder(kQuanta, kKeyframeInterval);
+  std::vector<std::uint8_t> stream;
+  auto values = trajectoryPoint(0);
+  ASSERT_GT(encoder.encodeNext(values, stream), 0);
+  auto size = stream.size();
+
+  for (double invalid : {std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+      1e13, -1e13})
+  {
+    auto invalid_values = values;
+    invalid_values[1] = invalid;
+    EXPECT_EQ(encoder.encodeNext(invalid_values, stream), 0) << invalid;
+    EXPECT_EQ(stream.size(), size);
+  }
+
+  // The skipped frames leave no gap in the stream
+  DeltaDecoder decoder(kQuanta);
+  std::vector<double> decoded(kQuanta.size());
+  ASSERT_GT(encoder.encodeNext(trajectoryPoint(1), stream), 0);
+  auto first_size = decoder.decodeNext(stream, decoded);
+  ASSERT_GT(first_size, 0);
+  std::vector<std::uint8_t> second(stream.begin() + first_size, stream.end());
+  EXPECT_EQ(decoder.decodeNext(second, decoded), static_cast<int>(second.size()));
+}
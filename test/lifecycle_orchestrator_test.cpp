@@ -0,0 +1,356 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lifecycle_msgs/msg/state.hpp"
+#include "lifecycle_msgs/msg/transition.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+
+#include "kroshu_ros2_core/LifecycleOrchestrator.hpp"
+
+using kroshu_ros2_core::LifecycleOrchestrator;
+using lifecycle_msgs::msg::State;
+using lifecycle_msgs::msg::Transition;
+using CallbackReturn =
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
+namespace
+{
+// A transition callback run by one of the managed nodes
+struct Event
+{
+  std::string node_name;
+  std::string transition;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+};
+
+class EventLog
+{
+public:
+  void add(const Event & event)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(event);
+  }
+
+  const Event & get(const std::string & node_name, const std::string & transition) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(
+      events_.begin(), events_.end(), [&](const Event & event) {
+        return event.node_name == node_name && event.transition == transition;
+      });
+    if (it == events_.end()) {
+      ADD_FAILURE() << transition << " of " << node_name << " was not called";
+      static const Event missing;
+      return missing;
+    }
+    return *it;
+  }
+
+  bool contains(const std::string & node_name, const std::string & transition) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::any_of(
+      events_.begin(), events_.end(), [&](const Event & event) {
+        return event.node_name == node_name && event.transition == transition;
+      });
+  }
+
+  // True, if the first callback finished before the second one started
+  bool before(
+    const std::string & first_node, const std::string & second_node,
+    const std::string & transition) const
+  {
+    return get(first_node, transition).end <= get(second_node, transition).start;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+};
+
+// Lifecycle node whose transitions take the given time and can be made to fail
+class ManagedTestNode : public rclcpp_lifecycle::LifecycleNode
+{
+public:
+  ManagedTestNode(const std::string & node_name, const std::string & name_space, EventLog & log)
+  : rclcpp_lifecycle::LifecycleNode(node_name, name_space), log_(log)
+  {
+  }
+
+  // Duration of the transitions, 10 ms for the ones not listed
+  std::map<std::string, std::chrono::milliseconds> delays;
+  std::string failing_transition;
+
+  CallbackReturn on_configure(const rclcpp_lifecycle::State &) override
+  {
+    return run("configure");
+  }
+
+  CallbackReturn on_cleanup(const rclcpp_lifecycle::State &) override
+  {
+    return run("cleanup");
+  }
+
+  CallbackReturn on_activate(const rclcpp_lifecycle::State &) override
+  {
+    return run("activate");
+  }
+
+  CallbackReturn on_deactivate(const rclcpp_lifecycle::State &) override
+  {
+    return run("deactivate");
+  }
+
+private:
+  CallbackReturn run(const std::string & transition)
+  {
+    Event event;
+    event.node_name = get_name();
+    event.transition = transition;
+    event.start = std::chrono::steady_clock::now();
+    auto delay = delays.find(transition);
+    std::this_thread::sleep_for(
+      delay != delays.end() ? delay->second : std::chrono::milliseconds(10));
+    event.end = std::chrono::steady_clock::now();
+    log_.add(event);
+    return transition == failing_transition ? CallbackReturn::FAILURE : CallbackReturn::SUCCESS;
+  }
+
+  EventLog & log_;
+};
+}  // namespace
+
+class LifecycleOrchestratorTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    // Every test uses its own namespace, so that services of the nodes of previous tests
+    //  cannot be mistaken for the current ones
+    name_space_ = std::string("/") +
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    // The names given to the orchestrator are resolved relative to this namespace
+    client_node_ = std::make_shared<rclcpp::Node>("lifecycle_orchestrator_test", name_space_);
+    orchestrator_ = std::make_unique<LifecycleOrchestrator>(client_node_);
+    executor_.add_node(client_node_);
+  }
+
+  void TearDown() override
+  {
+    executor_.cancel();
+    if (spin_thread_.joinable()) {
+      spin_thread_.join();
+    }
+  }
+
+  std::shared_ptr<ManagedTestNode> addNode(
+    const std::string & node_name, const std::vector<std::string> & dependencies = {})
+  {
+    auto node = std::make_shared<ManagedTestNode>(node_name, name_space_, log_);
+    executor_.add_node(node->get_node_base_interface());
+    orchestrator_->addNode(node_name, dependencies);
+    nodes_.push_back(node);
+    return node;
+  }
+
+  // Starts spinning and waits until the services of every node are discovered,
+  //  so that the deadlines are not spent on the discovery
+  void start()
+  {
+    spin_thread_ = std::thread([this]() {executor_.spin();});
+    for (const auto & node : nodes_) {
+      auto client = client_node_->create_client<lifecycle_msgs::srv::ChangeState>(
+        std::string(node->get_name()) + "/change_state");
+      ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(5))) << node->get_name();
+    }
+  }
+
+  std::uint8_t state(const std::string & node_name) const
+  {
+    for (const auto & node : nodes_) {
+      if (node->get_name() == node_name) {
+        return node->get_current_state().id();
+      }
+    }
+    ADD_FAILURE() << "Unknown node " << node_name;
+    return State::PRIMARY_STATE_UNKNOWN;
+  }
+
+  EventLog log_;
+  std::string name_space_;
+  rclcpp::Node::SharedPtr client_node_;
+  std::unique_ptr<LifecycleOrchestrator> orchestrator_;
+  // Every transition callback blocks a thread, independent nodes have to run in parallel
+  rclcpp::executors::MultiThreadedExecutor executor_ {rclcpp::ExecutorOptions(), 8};
+  std::thread spin_thread_;
+  std::vector<std::shared_ptr<ManagedTestNode>> nodes_;
+};
+
+TEST_F(LifecycleOrchestratorTest, AddNodeRejectsUnknownDependenciesAndDuplicates)
+{
+  orchestrator_->addNode("first");
+  EXPECT_THROW(orchestrator_->addNode("first"), std::invalid_argument);
+  EXPECT_THROW(orchestrator_->addNode("second", {"third"}), std::invalid_argument);
+  EXPECT_NO_THROW(orchestrator_->addNode("second", {"first"}));
+}
+
+TEST_F(LifecycleOrchestratorTest, TransitionsFollowTheDependencies)
+{
+  // Diamond: driver <- (robot_manager, io_manager) <- supervisor
+  for (const auto & node : {addNode("driver"), addNode("robot_manager", {"driver"}),
+      addNode("io_manager", {"driver"}), addNode("supervisor", {"robot_manager", "io_manager"})})
+  {
+    for (const auto & transition : {"configure", "activate", "deactivate", "cleanup"}) {
+      node->delays[transition] = std::chrono::milliseconds(100);
+    }
+  }
+  start();
+
+  auto result = orchestrator_->bringUp(std::chrono::seconds(5));
+  ASSERT_TRUE(result.success);
+  EXPECT_FALSE(result.deadline_exceeded);
+  ASSERT_EQ(result.transitions.size(), 8u);
+  for (const auto & report : result.transitions) {
+    EXPECT_TRUE(report.success);
+    EXPECT_FALSE(report.rollback);
+  }
+  for (const auto & transition : {"configure", "activate"}) {
+    EXPECT_TRUE(log_.before("driver", "robot_manager", transition));
+    EXPECT_TRUE(log_.before("driver", "io_manager", transition));
+    EXPECT_TRUE(log_.before("robot_manager", "supervisor", transition));
+    EXPECT_TRUE(log_.before("io_manager", "supervisor", transition));
+    // Independent nodes are not serialized
+    EXPECT_LT(log_.get("robot_manager", transition).start, log_.get("io_manager", transition).end);
+    EXPECT_LT(log_.get("io_manager", transition).start, log_.get("robot_manager", transition).end);
+  }
+  // Every node is configured before the first activation
+  EXPECT_LE(log_.get("supervisor", "configure").end, log_.get("driver", "activate").start);
+  EXPECT_EQ(state("supervisor"), State::PRIMARY_STATE_ACTIVE);
+
+  result = orchestrator_->bringDown(std::chrono::seconds(5));
+  ASSERT_TRUE(result.success);
+  for (const auto & transition : {"deactivate", "cleanup"}) {
+    EXPECT_TRUE(log_.before("supervisor", "robot_manager", transition));
+    EXPECT_TRUE(log_.before("supervisor", "io_manager", transition));
+    EXPECT_TRUE(log_.before("robot_manager", "driver", transition));
+    EXPECT_TRUE(log_.before("io_manager", "driver", transition));
+  }
+  EXPECT_EQ(state("driver"), State::PRIMARY_STATE_UNCONFIGURED);
+}
+
+TEST_F(LifecycleOrchestratorTest, FailureIsRolledBackInReverseDependencyOrder)
+{
+  addNode("driver");
+  addNode("robot_manager", {"driver"});
+  addNode("supervisor", {"robot_manager"})->failing_transition = "activate";
+  start();
+
+  auto result = orchestrator_->bringUp(std::chrono::seconds(5));
+  EXPECT_FALSE(result.success);
+  EXPECT_FALSE(result.deadline_exceeded);
+
+  // The activated nodes are deactivated, then every configured node is cleaned up
+  EXPECT_TRUE(log_.before("robot_manager", "driver", "deactivate"));
+  EXPECT_FALSE(log_.contains("supervisor", "deactivate"));
+  EXPECT_TRUE(log_.before("supervisor", "robot_manager", "cleanup"));
+  EXPECT_TRUE(log_.before("robot_manager", "driver", "cleanup"));
+  EXPECT_LE(log_.get("driver", "deactivate").end, log_.get("supervisor", "cleanup").start);
+  for (const auto & node_name : {"driver", "robot_manager", "supervisor"}) {
+    EXPECT_EQ(state(node_name), State::PRIMARY_STATE_UNCONFIGURED) << node_name;
+  }
+
+  std::size_t rollbacks = 0;
+  for (const auto & report : result.transitions) {
+    if (report.rollback) {
+      rollbacks++;
+      EXPECT_TRUE(report.success);
+    } else {
+      bool failing = report.node_name == "supervisor" &&
+        report.transition_id == Transition::TRANSITION_ACTIVATE;
+      EXPECT_EQ(report.success, !failing) << report.node_name;
+    }
+  }
+  EXPECT_EQ(rollbacks, 5u);
+}
+
+TEST_F(LifecycleOrchestratorTest, DeadlineStopsTheTransitionAndRollsBack)
+{
+  addNode("driver");
+  addNode("robot_manager")->delays["configure"] = std::chrono::milliseconds(450);
+  addNode("supervisor", {"robot_manager"});
+  start();
+
+  // The slow node completes while its state is queried for the rollback
+  auto result = orchestrator_->configure(std::chrono::milliseconds(400));
+  EXPECT_FALSE(result.success);
+  EXPECT_TRUE(result.deadline_exceeded);
+
+  // The dependent of the slow node is not started
+  EXPECT_FALSE(log_.contains("supervisor", "configure"));
+  // The abandoned request completed within the rollback deadline, so it is rolled back as well
+  EXPECT_TRUE(log_.contains("driver", "cleanup"));
+  EXPECT_TRUE(log_.contains("robot_manager", "cleanup"));
+  for (const auto & node_name : {"driver", "robot_manager", "supervisor"}) {
+    EXPECT_EQ(state(node_name), State::PRIMARY_STATE_UNCONFIGURED) << node_name;
+  }
+
+  ASSERT_GE(result.transitions.size(), 2u);
+  EXPECT_EQ(result.transitions[0].node_name, "driver");
+  EXPECT_TRUE(result.transitions[0].success);
+  EXPECT_EQ(result.transitions[1].node_name, "robot_manager");
+  EXPECT_FALSE(result.transitions[1].success);
+  EXPECT_FALSE(result.transitions[1].rollback);
+}
+
+TEST_F(LifecycleOrchestratorTest, NodeStillTransitioningAfterTheRollbackDeadlineIsNotRolledBack)
+{
+  addNode("driver");
+  addNode("robot_manager")->delays["configure"] = std::chrono::milliseconds(600);
+  start();
+
+  // The state of the slow node cannot be queried within the first half of the rollback deadline,
+  //  the rest is still enough to roll back the other node
+  auto result = orchestrator_->configure(std::chrono::milliseconds(200));
+  EXPECT_FALSE(result.success);
+  EXPECT_TRUE(result.deadline_exceeded);
+  EXPECT_TRUE(log_.contains("driver", "cleanup"));
+  EXPECT_EQ(state("driver"), State::PRIMARY_STATE_UNCONFIGURED);
+  EXPECT_FALSE(log_.contains("robot_manager", "cleanup"));
+}
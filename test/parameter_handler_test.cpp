@@ -0,0 +1,170 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "kroshu_ros2_core/ParameterHandler.hpp"
+
+using kroshu_ros2_core::ParameterConstraints;
+
+class ParameterHandlerTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node_ = std::make_shared<rclcpp::Node>("parameter_handler_test");
+    handler_.registerParameter<std::int64_t>(
+      "rate", 100, [this](const std::int64_t & value) {
+        rate_ = value;
+        return true;
+      }, node_->get_node_parameters_interface(), false,
+      ParameterConstraints::integerRange(10, 1000, 10));
+    handler_.registerParameter<double>(
+      "gain", 0.5, [this](const double & value) {
+        gain_ = value;
+        return true;
+      }, node_->get_node_parameters_interface(), false,
+      ParameterConstraints::floatingPointRange(0.0, 1.0, 0.1));
+    handler_.registerParameter<std::string>(
+      "mode", "position", [this](const std::string & value) {
+        mode_ = value;
+        return value != "torque";
+      }, node_->get_node_parameters_interface(), false,
+      ParameterConstraints::oneOf<std::string>({"position", "impedance", "torque"}));
+  }
+
+  rcl_interfaces::msg::SetParametersResult set(const std::vector<rclcpp::Parameter> & parameters)
+  {
+    return handler_.onParamChange(parameters);
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  kroshu_ros2_core::ParameterHandler handler_;
+  std::int64_t rate_ = 0;
+  double gain_ = 0.0;
+  std::string mode_;
+};
+
+TEST_F(ParameterHandlerTest, IntegerRangeWithStep)
+{
+  EXPECT_TRUE(set({rclcpp::Parameter("rate", 250)}).successful);
+  EXPECT_EQ(rate_, 250);
+  // The upper bound is valid regardless of the step, as in rclcpp
+  EXPECT_TRUE(set({rclcpp::Parameter("rate", 1000)}).successful);
+  EXPECT_EQ(rate_, 1000);
+
+  for (std::int64_t invalid : {255, 5, 1010}) {
+    auto result = set({rclcpp::Parameter("rate", invalid)});
+    EXPECT_FALSE(result.successful) << invalid;
+    EXPECT_NE(result.reason.find("with a step of 10"), std::string::npos) << result.reason;
+  }
+  EXPECT_EQ(rate_, 1000);
+}
+
+TEST_F(ParameterHandlerTest, FloatingPointRangeWithStep)
+{
+  EXPECT_TRUE(set({rclcpp::Parameter("gain", 0.3)}).successful);
+  EXPECT_DOUBLE_EQ(gain_, 0.3);
+  EXPECT_TRUE(set({rclcpp::Parameter("gain", 1.0)}).successful);
+
+  for (double invalid : {0.35, -0.1, 1.5}) {
+    EXPECT_FALSE(set({rclcpp::Parameter("gain", invalid)}).successful) << invalid;
+  }
+  EXPECT_DOUBLE_EQ(gain_, 1.0);
+}
+
+TEST_F(ParameterHandlerTest, OneOf)
+{
+  EXPECT_TRUE(set({rclcpp::Parameter("mode", "impedance")}).successful);
+  EXPECT_EQ(mode_, "impedance");
+
+  auto result = set({rclcpp::Parameter("mode", "velocity")});
+  EXPECT_FALSE(result.successful);
+  EXPECT_NE(result.reason.find("must be one of"), std::string::npos) << result.reason;
+  EXPECT_EQ(mode_, "impedance");
+}
+
+TEST_F(ParameterHandlerTest, WrongTypeIsRejected)
+{
+  auto result = set({rclcpp::Parameter("rate", 2.5)});
+  EXPECT_FALSE(result.successful);
+  EXPECT_NE(result.reason.find("must be of type"), std::string::npos) << result.reason;
+  EXPECT_EQ(rate_, 0);
+
+  EXPECT_FALSE(set({rclcpp::Parameter("unknown", 1)}).successful);
+}
+
+TEST_F(ParameterHandlerTest, InvalidParameterRejectsWholeBatch)
+{
+  auto result = set(
+    {rclcpp::Parameter("rate", 500), rclcpp::Parameter("gain", 0.7),
+      rclcpp::Parameter("mode", "velocity")});
+  EXPECT_FALSE(result.successful);
+  EXPECT_NE(result.reason.find("mode"), std::string::npos) << result.reason;
+  // No callback was called, not even for the valid parameters before the invalid one
+  EXPECT_EQ(rate_, 0);
+  EXPECT_DOUBLE_EQ(gain_, 0.0);
+  EXPECT_TRUE(mode_.empty());
+}
+
+TEST_F(ParameterHandlerTest, AcceptedValuesAreNotRolledBackIfACallbackRejects)
+{
+  // Valid according to the constraints, but rejected by the callback
+  auto result = set({rclcpp::Parameter("rate", 500), rclcpp::Parameter("mode", "torque")});
+  EXPECT_FALSE(result.successful);
+  EXPECT_NE(result.reason.find("rejected by the node"), std::string::npos) << result.reason;
+  // The callback of rate was called before and accepted its value
+  EXPECT_EQ(rate_, 500);
+  EXPECT_EQ(mode_, "torque");
+}
+
+TEST_F(ParameterHandlerTest, FailedDeclarationIsNotRegistered)
+{
+  // The default value violates the range published in the descriptor
+  EXPECT_THROW(
+    handler_.registerParameter<std::int64_t>(
+      "limit", 5000, [](const std::int64_t &) {return true;},
+      node_->get_node_parameters_interface(), false,
+      ParameterConstraints::integerRange(0, 100)),
+    rclcpp::exceptions::InvalidParameterValueException);
+  auto result = set({rclcpp::Parameter("limit", 50)});
+  EXPECT_FALSE(result.successful);
+  EXPECT_NE(result.reason.find("Invalid parameter name"), std::string::npos) << result.reason;
+
+  // A second registration does not replace the first one
+  EXPECT_THROW(
+    handler_.registerParameter<std::int64_t>(
+      "rate", 20, [](const std::int64_t &) {return false;},
+      node_->get_node_parameters_interface()),
+    rclcpp::exceptions::ParameterAlreadyDeclaredException);
+  EXPECT_TRUE(set({rclcpp::Parameter("rate", 20)}).successful);
+  EXPECT_EQ(rate_, 20);
+}
@@ -0,0 +1,181 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rcutils/logging.h"
+
+#include "kroshu_ros2_core/RealTimeLogger.hpp"
+
+using kroshu_ros2_core::RealTimeLogger;
+
+namespace
+{
+constexpr char kLoggerName[] = "realtime_logger_test";
+
+// Messages forwarded to rcutils under kLoggerName, with their severity
+std::mutex g_messages_mutex;
+std::vector<std::pair<int, std::string>> g_messages;
+
+void captureOutput(
+  const rcutils_log_location_t *, int severity, const char * name, rcutils_time_point_value_t,
+  const char * format, va_list * args)
+{
+  if (name == nullptr || std::string(name) != kLoggerName) {
+    return;
+  }
+  char buffer[1024];
+  vsnprintf(buffer, sizeof(buffer), format, *args);
+  std::lock_guard<std::mutex> lock(g_messages_mutex);
+  g_messages.emplace_back(severity, buffer);
+}
+
+std::vector<std::pair<int, std::string>> takeMessages()
+{
+  std::lock_guard<std::mutex> lock(g_messages_mutex);
+  std::vector<std::pair<int, std::string>> messages;
+  messages.swap(g_messages);
+  return messages;
+}
+
+void logThrottled(RealTimeLogger & logger, int index)
+{
+  KROSHU_RT_LOG_WARN_THROTTLE(logger, 50, "Throttled record %d", index);
+}
+}  // namespace
+
+class RealTimeLoggerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_EQ(rcutils_logging_initialize(), RCUTILS_RET_OK);
+    previous_handler_ = rcutils_logging_get_output_handler();
+    rcutils_logging_set_output_handler(captureOutput);
+    takeMessages();
+  }
+
+  void TearDown() override
+  {
+    rcutils_logging_set_output_handler(previous_handler_);
+  }
+
+  rcutils_logging_output_handler_t previous_handler_;
+};
+
+TEST_F(RealTimeLoggerTest, FormatIsRewrittenForTheStoredTypes)
+{
+  {
+    RealTimeLogger logger(kLoggerName);
+    std::int64_t signed_value = -5;
+    std::uint64_t unsigned_value = 7;
+    std::size_t size = 3;
+    std::string text = "abc";
+    // Length modifiers are replaced according to the stored type of the argument
+    KROSHU_RT_LOG_INFO(
+      logger, "%ld %lu %zu %5.2f %s %d%%", signed_value, unsigned_value, size, 3.14159, text,
+      42);
+    // Mismatching conversions are converted instead of reading garbage
+    KROSHU_RT_LOG_INFO(logger, "%d %.1f %s", 2.75, 3, 4);
+    // Missing arguments are printed as the conversion itself
+    KROSHU_RT_LOG_ERROR(logger, "Missing %d and %s", 1);
+  }
+
+  auto messages = takeMessages();
+  ASSERT_EQ(messages.size(), 3u);
+  EXPECT_EQ(messages[0].first, RCUTILS_LOG_SEVERITY_INFO);
+  EXPECT_EQ(messages[0].second, "-5 7 3  3.14 abc 42%");
+  EXPECT_EQ(messages[1].second, "2 3.0 <not a string>");
+  EXPECT_EQ(messages[2].first, RCUTILS_LOG_SEVERITY_ERROR);
+  EXPECT_EQ(messages[2].second, "Missing 1 and %s");
+}
+
+TEST_F(RealTimeLoggerTest, LongStringsAreTruncated)
+{
+  {
+    RealTimeLogger logger(kLoggerName);
+    KROSHU_RT_LOG_INFO(logger, "%s|%s", std::string(200, 'a'), std::string("b"));
+  }
+
+  auto messages = takeMessages();
+  ASSERT_EQ(messages.size(), 1u);
+  // The record has room for 127 characters and the terminator, nothing is left for the second
+  EXPECT_EQ(
+    messages[0].second,
+    std::string(kroshu_ros2_core::LogRecord::STRING_CAPACITY - 1, 'a') + "|");
+}
+
+TEST_F(RealTimeLoggerTest, RecordsAreDroppedIfTheQueueIsFull)
+{
+  constexpr int kRecords = 100;
+  std::uint64_t dropped;
+  {
+    RealTimeLogger logger(kLoggerName, 4);
+    for (int i = 0; i < kRecords; ++i) {
+      KROSHU_RT_LOG_INFO(logger, "Record %d", i);
+    }
+    dropped = logger.getDroppedCount();
+  }
+  // The drainer may have emptied the queue in between, but not a hundred times
+  EXPECT_GT(dropped, 0u);
+
+  auto messages = takeMessages();
+  std::uint64_t forwarded = 0;
+  std::uint64_t reported_dropped = 0;
+  int last_index = -1;
+  for (const auto & message : messages) {
+    int index;
+    unsigned long long count;  // NOLINT(runtime/int)
+    if (std::sscanf(message.second.c_str(), "Record %d", &index) == 1) {
+      // The records that fit are forwarded in order
+      EXPECT_GT(index, last_index);
+      last_index = index;
+      forwarded++;
+    } else if (std::sscanf(message.second.c_str(), "%llu real-time log records", &count) == 1) {
+      EXPECT_EQ(message.first, RCUTILS_LOG_SEVERITY_WARN);
+      reported_dropped += count;
+    }
+  }
+  EXPECT_EQ(reported_dropped, dropped);
+  EXPECT_EQ(forwarded + dropped, static_cast<std::uint64_t>(kRecords));
+}
+
+TEST_F(RealTimeLoggerTest, ThrottledCallSiteReportsSuppressedRecords)
+{
+  {
+    RealTimeLogger logger(kLoggerName);
+    for (int i = 0; i < 10; ++i) {
+      logThrottled(logger, i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    logThrottled(logger, 10);
+    logThrottled(logger, 11);
+  }
+
+  auto messages = takeMessages();
+  ASSERT_EQ(messages.size(), 2u);
+  EXPECT_EQ(messages[0].first, RCUTILS_LOG_SEVERITY_WARN);
+  EXPECT_EQ(messages[0].second, "Throttled record 0");
+  EXPECT_EQ(messages[1].second, "Throttled record 10 (9 similar messages suppressed)");
+}
@@ -0,0 +1,210 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/int64.hpp"
+
+#include "kroshu_ros2_core/RealTimePublisher.hpp"
+
+using kroshu_ros2_core::RealTimePublisher;
+using std_msgs::msg::Int64;
+
+namespace
+{
+constexpr char kTopic[] = "realtime_publisher_test";
+
+// Long enough that the background thread is reliably asleep between two checks of the slot
+constexpr std::chrono::milliseconds kSlowPoll(200);
+
+std::chrono::nanoseconds processCpuTime()
+{
+  timespec time;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+bool publish(RealTimePublisher<Int64> & publisher, std::int64_t value)
+{
+  auto msg = publisher.beginMessage();
+  if (msg == nullptr) {
+    return false;
+  }
+  msg->data = value;
+  publisher.commitMessage();
+  return true;
+}
+}  // namespace
+
+class RealTimePublisherTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node_ = std::make_shared<rclcpp::Node>("realtime_publisher_test");
+    publisher_ = node_->create_publisher<Int64>(kTopic, rclcpp::QoS(100).reliable());
+    subscription_ = node_->create_subscription<Int64>(
+      kTopic, rclcpp::QoS(100).reliable(), [this](Int64::ConstSharedPtr msg) {
+        std::lock_guard<std::mutex> lock(received_mutex_);
+        received_.push_back(msg->data);
+      });
+    executor_.add_node(node_);
+    spin_thread_ = std::thread([this]() {executor_.spin();});
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher_->get_subscription_count() == 0 &&
+      std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_GT(publisher_->get_subscription_count(), 0u);
+  }
+
+  void TearDown() override
+  {
+    executor_.cancel();
+    spin_thread_.join();
+  }
+
+  std::vector<std::int64_t> received()
+  {
+    std::lock_guard<std::mutex> lock(received_mutex_);
+    return received_;
+  }
+
+  bool waitForReceived(std::size_t count)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received().size() < count) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::Publisher<Int64>::SharedPtr publisher_;
+  rclcpp::Subscription<Int64>::SharedPtr subscription_;
+  rclcpp::executors::SingleThreadedExecutor executor_;
+  std::thread spin_thread_;
+  std::mutex received_mutex_;
+  std::vector<std::int64_t> received_;
+};
+
+TEST_F(RealTimePublisherTest, MessagesAreOnlyAcceptedWhileActive)
+{
+  RealTimePublisher<Int64> publisher(publisher_);
+  EXPECT_FALSE(publisher.isActive());
+  EXPECT_FALSE(publish(publisher, 1));
+
+  publisher.activate();
+  EXPECT_TRUE(publish(publisher, 2));
+  ASSERT_TRUE(waitForReceived(1));
+
+  publisher.deactivate();
+  EXPECT_FALSE(publish(publisher, 3));
+  // Rejected because of the deactivation, not dropped
+  EXPECT_EQ(publisher.getDroppedCount(), 0u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(received(), std::vector<std::int64_t>({2}));
+}
+
+TEST_F(RealTimePublisherTest, MessageIsDroppedWhileThePreviousOneIsPending)
+{
+  RealTimePublisher<Int64> publisher(publisher_, Int64(), kSlowPoll);
+  publisher.activate();
+  // The background thread is asleep after its first check of the empty slot
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(publish(publisher, 1));
+  EXPECT_FALSE(publish(publisher, 2));
+  EXPECT_FALSE(publish(publisher, 3));
+  EXPECT_EQ(publisher.getDroppedCount(), 2u);
+
+  ASSERT_TRUE(waitForReceived(1));
+  // The slot is released before publishing, the next message is accepted
+  EXPECT_TRUE(publish(publisher, 4));
+  ASSERT_TRUE(waitForReceived(2));
+  EXPECT_EQ(received(), std::vector<std::int64_t>({1, 4}));
+  EXPECT_EQ(publisher.getDroppedCount(), 2u);
+}
+
+TEST_F(RealTimePublisherTest, MessageCommittedBeforeDeactivationIsNotPublishedAfterActivation)
+{
+  RealTimePublisher<Int64> publisher(publisher_, Int64(), kSlowPoll);
+  publisher.activate();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // Committed in the last cycle of the active period, not yet seen by the background thread
+  EXPECT_TRUE(publish(publisher, 1));
+  publisher.deactivate();
+  publisher.activate();
+
+  // The slot is released once the background thread wakes up, without publishing the old message
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!publish(publisher, 2)) {
+    ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(waitForReceived(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(received(), std::vector<std::int64_t>({2}));
+}
+
+TEST_F(RealTimePublisherTest, BackgroundThreadIsBlockedWhileInactive)
+{
+  // Without a poll period the background thread spins while active
+  RealTimePublisher<Int64> publisher(publisher_, Int64(), std::chrono::microseconds(0));
+  const std::chrono::milliseconds measurement(200);
+
+  auto start = processCpuTime();
+  std::this_thread::sleep_for(measurement);
+  auto inactive_cpu_time = processCpuTime() - start;
+
+  publisher.activate();
+  start = processCpuTime();
+  std::this_thread::sleep_for(measurement);
+  auto active_cpu_time = processCpuTime() - start;
+
+  publisher.deactivate();
+  // The thread finishes its current check and blocks again
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  start = processCpuTime();
+  std::this_thread::sleep_for(measurement);
+  auto deactivated_cpu_time = processCpuTime() - start;
+
+  EXPECT_GT(active_cpu_time, measurement / 4);
+  EXPECT_LT(inactive_cpu_time, measurement / 10);
+  EXPECT_LT(deactivated_cpu_time, measurement / 10);
+  // The destructor wakes up and joins the blocked thread
+}
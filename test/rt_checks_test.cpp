@@ -0,0 +1,101 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the helpers used in real-time loops inside real-time sections.
+// The test is run with the kroshu_rt_checks library preloaded and KROSHU_RT_CHECKS=abort,
+//  so an allocation or blocking call in a section aborts the test.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "communication_helpers/serialization.hpp"
+#include "kroshu_ros2_core/ControllerHandler.hpp"
+#include "kroshu_ros2_core/RealTimeSection.hpp"
+
+using kroshu_ros2_core::ControlMode;
+using kroshu_ros2_core::ControllerType;
+
+class RealTimeChecksTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Without the library the sections are not checked and the test would pass vacuously
+    ASSERT_TRUE(kroshu_rt_section_enter != nullptr) << "kroshu_rt_checks is not preloaded";
+  }
+};
+
+TEST_F(RealTimeChecksTest, SerializationDoesNotAllocate)
+{
+  std::vector<std::uint8_t> serialized;
+  serialized.reserve(64);
+  int integer_out = 0;
+  double double_out = 0.0;
+
+  // Warm-up outside of the section
+  kroshu_ros2_core::serializeNext(1, serialized);
+  kroshu_ros2_core::serializeNext(1.0, serialized);
+  serialized.clear();
+
+  int integer_size;
+  int double_size;
+  {
+    KROSHU_RT_SECTION();
+    kroshu_ros2_core::serializeNext(42, serialized);
+    kroshu_ros2_core::serializeNext(0.5, serialized);
+    integer_size = kroshu_ros2_core::deserializeNext(serialized, integer_out);
+    double_size = kroshu_ros2_core::deserializeNext(serialized, double_out);
+  }
+  EXPECT_EQ(serialized.size(), sizeof(int) + sizeof(double));
+  EXPECT_EQ(integer_size, static_cast<int>(sizeof(int)));
+  EXPECT_EQ(double_size, static_cast<int>(sizeof(double)));
+}
+
+TEST_F(RealTimeChecksTest, ControllersForSwitchDoNotAllocate)
+{
+  kroshu_ros2_core::ControllerHandler handler({"joint_state_broadcaster", "control_mode_handler"});
+  handler.UpdateControllerName(
+    ControllerType::JOINT_POSITION_CONTROLLER_TYPE,
+    "joint_trajectory_controller");
+  handler.UpdateControllerName(
+    ControllerType::JOINT_IMPEDANCE_CONTROLLER_TYPE,
+    "joint_impedance_controller");
+  handler.UpdateControllerName(ControllerType::TORQUE_CONTROLLER_TYPE, "effort_controller");
+  handler.GetControllersForSwitch(ControlMode::JOINT_POSITION_CONTROL);
+  handler.ApproveControllerActivation();
+  handler.ApproveControllerDeactivation();
+
+  // Warm-up with the same switch outside of the section
+  std::vector<std::string> activate;
+  std::vector<std::string> deactivate;
+  handler.GetControllersForSwitch(ControlMode::JOINT_IMPEDANCE_CONTROL, activate, deactivate);
+  {
+    KROSHU_RT_SECTION();
+    handler.GetControllersForSwitch(ControlMode::JOINT_IMPEDANCE_CONTROL, activate, deactivate);
+  }
+  EXPECT_EQ(activate, std::vector<std::string>({"joint_impedance_controller"}));
+  EXPECT_TRUE(deactivate.empty());
+
+  handler.GetControllersForSwitch(ControlMode::JOINT_TORQUE_CONTROL, activate, deactivate);
+  {
+    KROSHU_RT_SECTION();
+    handler.GetControllersForSwitch(ControlMode::JOINT_TORQUE_CONTROL, activate, deactivate);
+  }
+  EXPECT_EQ(activate, std::vector<std::string>({"effort_controller"}));
+  EXPECT_EQ(deactivate, std::vector<std::string>({"joint_trajectory_controller"}));
+}
@@ -0,0 +1,200 @@
+// Copyright 2026 KUKA Hungaria Kft.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "kroshu_ros2_core/SharedStatusBlock.hpp"
+
+using kroshu_ros2_core::ControlMode;
+using kroshu_ros2_core::SharedStatusLayout;
+using kroshu_ros2_core::SharedStatusReader;
+using kroshu_ros2_core::SharedStatusWriter;
+
+class SharedStatusBlockTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Unique per process and test, so parallel test runs do not share the block
+    name_ = "/kroshu_status_test_" + std::to_string(getpid()) + "_" +
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    shm_unlink(name_.c_str());
+  }
+
+  void TearDown() override
+  {
+    if (layout_ != nullptr) {
+      munmap(layout_, sizeof(SharedStatusLayout));
+    }
+    shm_unlink(name_.c_str());
+  }
+
+  // Maps the block directly, to simulate a writer interrupted in the middle of a write
+  SharedStatusLayout & rawLayout()
+  {
+    if (layout_ == nullptr) {
+      int fd = shm_open(name_.c_str(), O_RDWR, 0);
+      EXPECT_GE(fd, 0);
+      void * memory = mmap(
+        nullptr, sizeof(SharedStatusLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+      EXPECT_NE(memory, MAP_FAILED);
+      layout_ = static_cast<SharedStatusLayout *>(memory);
+    }
+    return *layout_;
+  }
+
+  std::string name_;
+  SharedStatusLayout * layout_ = nullptr;
+};
+
+TEST_F(SharedStatusBlockTest, ReaderAttachesBeforeAndAfterTheWriter)
+{
+  SharedStatusReader early_reader(name_, std::chrono::seconds(10));
+  EXPECT_FALSE(early_reader.attach());
+  auto status = early_reader.read();
+  EXPECT_FALSE(status.is_configured);
+  EXPECT_FALSE(early_reader.isAlive());
+
+  SharedStatusWriter writer(name_);
+  ASSERT_TRUE(early_reader.attach());
+  // Attached, but nothing was written yet
+  EXPECT_FALSE(early_reader.read().is_configured);
+  EXPECT_FALSE(early_reader.isAlive());
+
+  writer.write(true, ControlMode::JOINT_IMPEDANCE_CONTROL);
+  status = early_reader.read();
+  EXPECT_TRUE(status.is_configured);
+  EXPECT_EQ(status.control_mode, ControlMode::JOINT_IMPEDANCE_CONTROL);
+  EXPECT_EQ(status.heartbeat, 1u);
+  EXPECT_TRUE(early_reader.isAlive());
+
+  SharedStatusReader late_reader(name_, std::chrono::seconds(10));
+  ASSERT_TRUE(late_reader.attach());
+  EXPECT_TRUE(late_reader.attach());
+  status = late_reader.read();
+  EXPECT_TRUE(status.is_configured);
+  EXPECT_EQ(status.control_mode, ControlMode::JOINT_IMPEDANCE_CONTROL);
+}
+
+TEST_F(SharedStatusBlockTest, WriteInProgressReturnsPreviousStatus)
+{
+  SharedStatusWriter writer(name_);
+  SharedStatusReader reader(name_, std::chrono::seconds(10));
+  ASSERT_TRUE(reader.attach());
+  writer.write(true, ControlMode::JOINT_POSITION_CONTROL);
+  ASSERT_TRUE(reader.read().is_configured);
+
+  // Half of a write: odd sequence, some fields already changed
+  auto & layout = rawLayout();
+  auto sequence = layout.sequence.load();
+  layout.sequence.store(sequence + 1);
+  layout.is_configured.store(0);
+  layout.control_mode.store(static_cast<std::uint32_t>(ControlMode::JOINT_TORQUE_CONTROL));
+  auto status = reader.read();
+  EXPECT_TRUE(status.is_configured);
+  EXPECT_EQ(status.control_mode, ControlMode::JOINT_POSITION_CONTROL);
+
+  // The completed write is read
+  layout.sequence.store(sequence + 2);
+  status = reader.read();
+  EXPECT_FALSE(status.is_configured);
+  EXPECT_EQ(status.control_mode, ControlMode::JOINT_TORQUE_CONTROL);
+}
+
+TEST_F(SharedStatusBlockTest, ConcurrentReadsAreConsistent)
+{
+  SharedStatusWriter writer(name_);
+  SharedStatusReader reader(name_, std::chrono::seconds(10));
+  ASSERT_TRUE(reader.attach());
+  writer.write(true, ControlMode::JOINT_POSITION_CONTROL);
+
+  // Configured is always written with position control, not configured with torque control
+  std::atomic_bool stop {false};
+  std::thread writer_thread([&writer, &stop]() {
+      for (std::uint64_t i = 0; !stop; ++i) {
+        bool configured = i % 2 == 0;
+        writer.write(
+          configured,
+          configured ? ControlMode::JOINT_POSITION_CONTROL : ControlMode::JOINT_TORQUE_CONTROL);
+      }
+    });
+  std::uint64_t last_heartbeat = 0;
+  for (int i = 0; i < 100000; ++i) {
+    auto status = reader.read();
+    ASSERT_EQ(
+      status.is_configured,
+      status.control_mode == ControlMode::JOINT_POSITION_CONTROL) << "read " << i;
+    ASSERT_GE(status.heartbeat, last_heartbeat);
+    last_heartbeat = status.heartbeat;
+  }
+  stop = true;
+  writer_thread.join();
+}
+
+TEST_F(SharedStatusBlockTest, StaleHeartbeatIsNotConfigured)
+{
+  SharedStatusWriter writer(name_);
+  SharedStatusReader reader(name_, std::chrono::milliseconds(20));
+  ASSERT_TRUE(reader.attach());
+  writer.write(true, ControlMode::JOINT_POSITION_CONTROL);
+  EXPECT_TRUE(reader.read().is_configured);
+  EXPECT_TRUE(reader.isAlive());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto status = reader.read();
+  EXPECT_FALSE(status.is_configured);
+  EXPECT_FALSE(reader.isAlive());
+  // The rest of the status is still reported
+  EXPECT_EQ(status.control_mode, ControlMode::JOINT_POSITION_CONTROL);
+
+  writer.write(true, ControlMode::JOINT_POSITION_CONTROL);
+  EXPECT_TRUE(reader.read().is_configured);
+  EXPECT_TRUE(reader.isAlive());
+}
+
+TEST_F(SharedStatusBlockTest, RestartedWriterCompletesInterruptedWrite)
+{
+  SharedStatusReader reader(name_, std::chrono::seconds(10));
+  {
+    auto writer = std::make_unique<SharedStatusWriter>(name_);
+    writer->write(true, ControlMode::JOINT_POSITION_CONTROL);
+    ASSERT_TRUE(reader.attach());
+    ASSERT_TRUE(reader.read().is_configured);
+    // The writer crashes in the middle of a write
+    auto & layout = rawLayout();
+    layout.sequence.store(layout.sequence.load() + 1);
+    layout.is_configured.store(0);
+  }
+  EXPECT_TRUE(reader.read().is_configured);
+
+  SharedStatusWriter restarted_writer(name_);
+  EXPECT_EQ(rawLayout().sequence.load() % 2, 0u);
+  restarted_writer.write(true, ControlMode::JOINT_IMPEDANCE_CONTROL);
+  // The reader does not have to reattach, the heartbeat continues
+  auto status = reader.read();
+  EXPECT_TRUE(status.is_configured);
+  EXPECT_EQ(status.control_mode, ControlMode::JOINT_IMPEDANCE_CONTROL);
+  EXPECT_EQ(status.heartbeat, 2u);
+}